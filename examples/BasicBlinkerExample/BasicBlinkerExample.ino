@@ -1,5 +1,8 @@
 #include <BasicTimer.h>
 
+// Forward declaration of our LED update function
+void updateLED(bool onOrOff);
+
 //The Blinkers are useful for blinking LEDs or anything else that you want
 //turned on and off in rhythm using true/false values 
 
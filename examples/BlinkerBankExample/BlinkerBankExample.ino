@@ -0,0 +1,43 @@
+#include <BasicTimer.h>
+
+// 16 status LEDs on two daisy-chained 74HC595 shift registers
+const uint8_t dataPin = 2;
+const uint8_t clockPin = 3;
+const uint8_t latchPin = 4;
+
+// Forward declaration of our port writer
+void write_leds(uint32_t states, uint32_t changed);
+
+// One bank updates all 16 blinkers against a single clock read and calls
+// write_leds() only when at least one LED has changed
+BlinkerBank<16> leds(write_leds);
+
+void setup() {
+  pinMode(dataPin, OUTPUT);
+  pinMode(clockPin, OUTPUT);
+  pinMode(latchPin, OUTPUT);
+
+  // Start every LED from the same timestamp so that LEDs with related 
+  // blink times stay in step
+  BasicTimer::TickType start = BasicTimer::now();
+  for (uint8_t i = 0; i < 16; i++) {
+    leds.begin(i, 100 * (i % 4 + 1), start);
+  }
+
+  // LED 15 is a power indicator that stays on
+  leds.stop(15, true);
+  leds.flush();
+}
+
+void loop() {
+  leds.run();
+}
+
+void write_leds(uint32_t states, uint32_t /* changed */) {
+  // All 16 LEDs are updated in one latch.  On an AVR with 8 LEDs on one
+  // port this could be a single PORTD = states; instead.
+  digitalWrite(latchPin, LOW);
+  shiftOut(dataPin, clockPin, MSBFIRST, states >> 8);
+  shiftOut(dataPin, clockPin, MSBFIRST, states);
+  digitalWrite(latchPin, HIGH);
+}
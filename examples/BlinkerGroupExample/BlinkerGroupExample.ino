@@ -0,0 +1,35 @@
+#include <BasicTimer.h>
+
+// 8 LEDs on pins 2 to 9.  The group's master timer ticks 8 times per 
+// 400 ms blink time, and every LED works out its state from that one tick
+// count, so they can never drift apart.
+BlinkerGroup<8, 8> leds(400);
+
+void setup() {
+  for (uint8_t i = 0; i < 8; i++) {
+    pinMode(2 + i, OUTPUT);
+  }
+
+  // LEDs 0 to 5 make a chase: the same blink time, each one tick (50 ms)
+  // behind the one before
+  for (uint8_t i = 0; i < 6; i++) {
+    leds.setDivider(i, 1, 8 - i);
+  }
+
+  // LED 6 blinks twice as fast and LED 7 half as fast, both in step with 
+  // the chase
+  leds.setMultiplier(6, 2);
+  leds.setDivider(7, 2);
+
+  leds.begin();
+}
+
+void loop() {
+  // One timer comparison per loop, whatever the number of LEDs.  Outputs 
+  // only need updating when something changed.
+  if (leds.run()) {
+    for (uint8_t i = 0; i < 8; i++) {
+      digitalWrite(2 + i, leds.getState(i));
+    }
+  }
+}
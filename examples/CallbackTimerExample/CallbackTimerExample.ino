@@ -14,7 +14,7 @@ CallbackTimer exampleTimer1;
 // the callback function to on_timeout_2(), and the mode to continuous
 // at construction. 
 // 
-// Timers can have two modes:  
+// Timers can have four modes:  
 //
 //   TIMER_RUN_MODE_ONE_SHOT is the default.  Once started, the timer will 
 //   run and the first time it expires the callback will be executed.  
@@ -24,6 +24,14 @@ CallbackTimer exampleTimer1;
 //   will run and each time it expires, it will reset itself and the callback
 //   will be executed each time (in this case once every 250ms)
 //
+//   TIMER_RUN_MODE_PERIODIC is like continuous, but the timer moves its
+//   deadline forward by exactly one timeout instead of resetting, so it 
+//   never drifts even if loop() is slow to call run().  If whole periods 
+//   are missed it skips to the latest one (see missedPeriods()).
+//
+//   TIMER_RUN_MODE_PERIODIC_CATCH_UP is like periodic, but the callback
+//   is executed once for every period that ended, including missed ones.
+//
 CallbackTimer exampleTimer2(250, on_timeout_2, TIMER_RUN_MODE_CONTINUOUS);
 
 
@@ -0,0 +1,52 @@
+#include <BasicTimer.h>
+
+// Four buttons wired from these pins to ground, read with INPUT_PULLUP
+const uint8_t buttonPins[4] = {2, 3, 4, 5};
+
+// Debounce all four at once, sampling every 5ms.  Every button reads LOW 
+// when pressed, so all four bits are marked active low.
+DebounceBank<4> buttons(0x0F);
+
+// Each button toggles its own LED
+const uint8_t ledPins[4] = {8, 9, 10, 11};
+bool ledStates[4] = {false, false, false, false};
+
+uint8_t readButtons() {
+  uint8_t raw = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    if (digitalRead(buttonPins[i])) raw |= 1 << i;
+  }
+  return raw;
+}
+
+void setup() {
+  Serial.begin(115200);
+  for (uint8_t i = 0; i < 4; i++) {
+    pinMode(buttonPins[i], INPUT_PULLUP);
+    pinMode(ledPins[i], OUTPUT);
+  }
+  // Accept the current readings as settled, so a button held down at 
+  // power up does not count as a press
+  buttons.reset(readButtons());
+}
+
+void loop() {
+  // Reading four pins is cheap enough to do every loop; update() only 
+  // takes a sample when the 5ms sample timer has expired.  On AVR the
+  // pins could also be read in one go from a PINx register.
+  if (!buttons.update(readButtons())) return;
+
+  for (uint8_t i = 0; i < 4; i++) {
+    if (buttons.wasPressed(i)) {
+      ledStates[i] = !ledStates[i];
+      digitalWrite(ledPins[i], ledStates[i]);
+      Serial.print(F("button "));
+      Serial.print(i);
+      Serial.println(F(" pressed"));
+    }
+  }
+  if (buttons.released()) {
+    Serial.print(F("released mask: "));
+    Serial.println(buttons.released());
+  }
+}
@@ -0,0 +1,57 @@
+#include <BasicTimer.h>
+
+// A DelegateTimer is a CallbackTimer whose callback can carry context, so 
+// an object can own a timer that calls one of its own member functions
+// without a global trampoline function.
+class Led {
+  public:
+    Led(uint8_t ledPin, unsigned long period): pin(ledPin), state(LOW), 
+                                               timer(period, nullptr, TIMER_RUN_MODE_PERIODIC) {}
+
+    void begin() {
+      pinMode(pin, OUTPUT);
+      // Bind toggle() on this object.  Nothing is allocated.
+      timer.onExpire(TimerDelegate::bind<Led, &Led::toggle>(this));
+      timer.start();
+    }
+
+    void run() { timer.run(); }
+
+    void toggle() {
+      state = !state;
+      digitalWrite(pin, state);
+    }
+
+  private:
+    uint8_t pin;
+    bool state;
+    DelegateTimer timer;
+};
+
+Led redLed(2, 250);
+Led greenLed(3, 400);
+
+// A small lambda can be stored too, as long as its captures fit in two 
+// pointers and are plain values or references
+unsigned long reports = 0;
+DelegateTimer reportTimer(1000, nullptr, TIMER_RUN_MODE_CONTINUOUS);
+
+void setup() {
+  Serial.begin(9600);
+  redLed.begin();
+  greenLed.begin();
+
+  unsigned long* count = &reports;
+  reportTimer.onExpire([count]() {
+    (*count)++;
+    Serial.print(F("Reports: "));
+    Serial.println(*count);
+  });
+  reportTimer.start();
+}
+
+void loop() {
+  redLed.run();
+  greenLed.run();
+  reportTimer.run();
+}
@@ -0,0 +1,78 @@
+#include <BasicTimer.h>
+
+// Forward declarations of our callback functions
+void on_blink();
+void on_report();
+
+// Timers counted down by a 1 ms tick interrupt.  Expired timers are queued 
+// and their callbacks run from loop() when it calls dispatch(), so a slow 
+// loop() delays the callback but not the detection of the expiry.
+InterruptTimers<4> timers;
+
+const uint8_t BLINK = 0;
+const uint8_t REPORT = 1;
+
+bool ledState = LOW;
+
+#if defined(__AVR_ATmega328P__)
+// Timer2 in CTC mode: 16 MHz / 64 / 250 = 1 kHz
+void startTickInterrupt() {
+  TCCR2A = _BV(WGM21);
+  TCCR2B = _BV(CS22);
+  OCR2A = 249;
+  TIMSK2 = _BV(OCIE2A);
+}
+
+ISR(TIMER2_COMPA_vect) {
+  timers.tick();
+}
+
+void pollTick() {}
+#else
+// On other boards call timers.tick() from a 1 ms hardware timer interrupt.
+// Without one, this sketch falls back to ticking from loop().
+unsigned long lastTick;
+
+void startTickInterrupt() {
+  lastTick = millis();
+}
+
+void pollTick() {
+  while (millis() - lastTick >= 1) {
+    lastTick++;
+    timers.tick();
+  }
+}
+#endif
+
+void setup() {
+  Serial.begin(9600);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  timers.onExpire(BLINK, on_blink);
+  timers.onExpire(REPORT, on_report);
+
+  // start() and stop() are applied by the interrupt at its next tick
+  timers.start(BLINK, 250, TIMER_RUN_MODE_PERIODIC);
+  timers.start(REPORT, 1000, TIMER_RUN_MODE_PERIODIC);
+
+  startTickInterrupt();
+}
+
+void loop() {
+  pollTick();
+  timers.dispatch();
+}
+
+void on_blink() {
+  ledState = !ledState;
+  digitalWrite(LED_BUILTIN, ledState);
+}
+
+void on_report() {
+  // expiredAt() is the tick the timer expired on, not when loop() got here
+  Serial.print(F("Report due at tick "));
+  Serial.print(timers.expiredAt());
+  Serial.print(F(", dropped expiries: "));
+  Serial.println(timers.overflows());
+}
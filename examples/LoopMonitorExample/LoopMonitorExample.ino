@@ -0,0 +1,51 @@
+#include <BasicTimer.h>
+
+// Every timer below relies on loop() coming round faster than its 
+// timeout.  The monitor checks that each loop() takes under 2ms.
+void onOverrun(unsigned long period);
+LoopMonitor loopMonitor(2000, onOverrun);
+
+BasicBlinker blinker(250);
+BasicTimer slowTaskTimer(3000);
+BasicTimer reportTimer(10000);
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+  blinker.reset();
+  slowTaskTimer.begin();
+  reportTimer.begin();
+  // Start measuring last so setup() is not counted as a long loop
+  loopMonitor.begin();
+}
+
+void loop() {
+  // Call once per loop(), at the top
+  loopMonitor.run();
+
+  blinker.run();
+  digitalWrite(LED_BUILTIN, blinker ? HIGH : LOW);
+
+  if (slowTaskTimer.hasExpired()) {
+    slowTaskTimer.reset();
+    // A blocking task that overruns the loop budget every 3 seconds
+    delay(15);
+  }
+
+  if (reportTimer.hasExpired()) {
+    reportTimer.reset();
+    // Prints lines like
+    //   loops=412080 overruns=3 mean=24 p99=31 worst=15012
+    loopMonitor.printTo(Serial);
+    Serial.print(F("median loop: "));
+    Serial.print(loopMonitor.percentile(50));
+    Serial.println(F("us or less"));
+    loopMonitor.clear();
+  }
+}
+
+void onOverrun(unsigned long period) {
+  Serial.print(F("loop overrun: "));
+  Serial.print(period);
+  Serial.println(F("us"));
+}
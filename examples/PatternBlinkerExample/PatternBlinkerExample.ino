@@ -0,0 +1,39 @@
+#include <BasicTimer.h>
+
+// Patterns are lists of step times in milliseconds, kept in flash.
+// Even steps are on and odd steps are off.
+const uint16_t heartbeat[] PROGMEM = { 100, 100, 100, 700 };
+
+const uint16_t sos[] PROGMEM = {
+  150, 150, 150, 150, 150, 450,   // . . .
+  450, 150, 450, 150, 450, 450,   // - - -
+  150, 150, 150, 150, 150, 1500   // . . .
+};
+
+const uint8_t buttonPin = 4;
+
+PatternBlinker blinker;
+bool playingSos = false;
+
+void setup() {
+  pinMode(LED_BUILTIN, OUTPUT);
+  pinMode(buttonPin, INPUT_PULLUP);
+
+  // Repeat the heartbeat forever
+  blinker.play(heartbeat, 4);
+}
+
+void loop() {
+  blinker.run();
+  digitalWrite(LED_BUILTIN, blinker);
+
+  // Play SOS three times when the button is pressed, then go back to 
+  // the heartbeat.  The new pattern starts straight away.
+  if (!playingSos && digitalRead(buttonPin) == LOW) {
+    blinker.play(sos, 18, 3);
+    playingSos = true;
+  } else if (playingSos && !blinker.isPlaying()) {
+    blinker.play(heartbeat, 4);
+    playingSos = false;
+  }
+}
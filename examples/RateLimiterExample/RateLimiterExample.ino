@@ -0,0 +1,47 @@
+#include <BasicTimer.h>
+
+// Log messages: bursts of up to 5, then 2 more every second
+TokenBucket logLimit(5, 2, 1000);
+
+// "Radio" transmissions: never closer together than 250ms, no bursts
+LeakyBucket radioLimit(250);
+
+unsigned long dropped = 0;
+BasicTimer eventTimer(20);
+
+void setup() {
+  Serial.begin(115200);
+  eventTimer.begin();
+}
+
+void loop() {
+  // Something noisy happens every 20ms and wants to be logged and sent
+  if (!eventTimer.hasExpired()) return;
+  eventTimer.reset();
+
+  if (logLimit.tryAcquire()) {
+    Serial.print(F("event at "));
+    Serial.print(millis());
+    if (dropped) {
+      Serial.print(F(", "));
+      Serial.print(dropped);
+      Serial.print(F(" not logged"));
+      dropped = 0;
+    }
+    Serial.println();
+  } else {
+    dropped++;
+  }
+
+  if (radioLimit.tryAcquire()) {
+    Serial.println(F("transmit"));
+  } else {
+    // Rather than retrying blindly, ask how long until a slot is free
+    unsigned long wait = radioLimit.timeUntilAvailable(1);
+    if (wait > 200) {
+      Serial.print(F("radio busy for "));
+      Serial.print(wait);
+      Serial.println(F("ms"));
+    }
+  }
+}
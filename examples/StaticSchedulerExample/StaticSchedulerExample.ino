@@ -0,0 +1,53 @@
+#include <BasicTimer.h>
+
+// Forward declarations of our task functions
+void blink_led();
+void read_sensor();
+void print_report();
+
+// Three periodic tasks.  The scheduler works out at compile time that it 
+// needs a 50 ms base tick (the GCD of every period and offset) and that 
+// the schedule repeats every 1000 ms (the LCM of the periods).
+//
+// The report task is offset by 50 ms so that it never lands in the same
+// tick as the sensor read.  The 2 is checked at compile time: if more than
+// two tasks could ever be due together, the sketch will not build.
+TStaticScheduler<2,
+  StaticTask<250, blink_led>,
+  StaticTask<100, read_sensor>,
+  StaticTask<1000, print_report, 50>
+> scheduler;
+
+bool ledState = LOW;
+int lastReading = 0;
+
+void setup() {
+  Serial.begin(9600);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  Serial.print(F("Base tick: "));
+  Serial.println(scheduler.Tick);
+  Serial.print(F("Most tasks due in one tick: "));
+  Serial.println(scheduler.MaxDuePerTick);
+
+  scheduler.begin();
+}
+
+void loop() {
+  // One timer check per loop, whatever the number of tasks
+  scheduler.run();
+}
+
+void blink_led() {
+  ledState = !ledState;
+  digitalWrite(LED_BUILTIN, ledState);
+}
+
+void read_sensor() {
+  lastReading = analogRead(A0);
+}
+
+void print_report() {
+  Serial.print(F("Sensor: "));
+  Serial.println(lastReading);
+}
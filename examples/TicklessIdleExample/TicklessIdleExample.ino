@@ -0,0 +1,66 @@
+#include <BasicTimer.h>
+
+#if defined(__AVR__)
+#include <avr/sleep.h>
+#endif
+
+// Forward declaration of our callback function
+void on_report();
+
+// Sleep hook for the TicklessIdle.  It is called with the number of 
+// milliseconds until the next timer is due.  On AVR we use idle sleep, 
+// which is woken every millisecond by the millis() interrupt, so we 
+// go back to sleep until enough time has passed.
+void sleep_for(unsigned long duration) {
+#if defined(__AVR__)
+  unsigned long start = millis();
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  while (millis() - start < duration) {
+    sleep_mode();
+  }
+#else
+  delay(duration);
+#endif
+}
+
+// The TicklessIdle sleeps until the earliest registered timer is due,
+// then runs everything that came due.  It can hold up to 8 timers by
+// default.
+TicklessIdle<> idle(sleep_for);
+
+BasicBlinker ledBlinker(500);
+CallbackTimer reportTimer(2000, on_report, TIMER_RUN_MODE_CONTINUOUS);
+StaticTimer<750> pollTimer;
+
+void setup() {
+  Serial.begin(9600);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  // Register everything the idle loop should wait for
+  idle.add(ledBlinker);
+  idle.add(reportTimer);
+  idle.add(pollTimer);
+
+  ledBlinker.reset();
+  reportTimer.start();
+  pollTimer.reset();
+}
+
+void loop() {
+  // Sleeps until something is due, then runs the blinker and callback timer
+  idle.idle();
+
+  digitalWrite(LED_BUILTIN, ledBlinker);
+
+  // Plain timers are still checked as usual, idle() just makes sure 
+  // we wake up in time for them
+  if (pollTimer.hasExpired()) {
+    pollTimer.reset();
+    analogRead(A0);
+  }
+}
+
+void on_report() {
+  Serial.print(F("Times slept: "));
+  Serial.println(idle.sleepCount());
+}
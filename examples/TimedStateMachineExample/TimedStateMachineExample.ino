@@ -0,0 +1,57 @@
+#include <BasicTimer.h>
+
+// Pins for one traffic light
+struct TrafficLight {
+  uint8_t red;
+  uint8_t yellow;
+  uint8_t green;
+};
+
+// Forward declarations of our entry actions
+void show_red(TimedStateMachine& machine);
+void show_green(TimedStateMachine& machine);
+void show_yellow(TimedStateMachine& machine);
+
+// The state numbers are the rows of the table
+enum { RED, GREEN, YELLOW };
+
+// Each row is { time in the state, the state that follows, entry action }.
+// The table is constant and kept in flash, and is shared by both lights.
+const TimedState trafficLightStates[] PROGMEM = {
+  { 5000, GREEN,  show_red    },
+  { 4000, YELLOW, show_green  },
+  { 1000, RED,    show_yellow },
+};
+
+TrafficLight northSouth = { 2, 3, 4 };
+TrafficLight eastWest = { 5, 6, 7 };
+
+// One BasicTimer per machine replaces a timer per phase.  The context 
+// pointer tells the shared entry actions which light to switch.
+TimedStateMachine northSouthLight(trafficLightStates, 3, TimedStateMachine::TIMED_STATE_TABLE_PROGMEM, &northSouth);
+TimedStateMachine eastWestLight(trafficLightStates, 3, TimedStateMachine::TIMED_STATE_TABLE_PROGMEM, &eastWest);
+
+void show(TimedStateMachine& machine, bool red, bool yellow, bool green) {
+  TrafficLight* light = static_cast<TrafficLight*>(machine.context());
+  digitalWrite(light->red, red);
+  digitalWrite(light->yellow, yellow);
+  digitalWrite(light->green, green);
+}
+
+void show_red(TimedStateMachine& machine) { show(machine, HIGH, LOW, LOW); }
+void show_green(TimedStateMachine& machine) { show(machine, LOW, LOW, HIGH); }
+void show_yellow(TimedStateMachine& machine) { show(machine, LOW, HIGH, LOW); }
+
+void setup() {
+  for (uint8_t pin = 2; pin <= 7; pin++) {
+    pinMode(pin, OUTPUT);
+  }
+  // North-south starts on green while east-west waits on red
+  northSouthLight.begin(GREEN);
+  eastWestLight.begin(RED);
+}
+
+void loop() {
+  northSouthLight.run();
+  eastWestLight.run();
+}
@@ -0,0 +1,30 @@
+#include <BasicTimer.h>
+
+// A TimerBank keeps many timers in parallel arrays and checks them all in
+// one scan.  Here each of 8 LEDs blinks at its own rate.
+const uint8_t LED_COUNT = 8;
+const uint8_t firstPin = 2;
+
+TimerBank<LED_COUNT> bank;
+bool ledState[LED_COUNT];
+
+void setup() {
+  for (uint8_t i = 0; i < LED_COUNT; i++) {
+    pinMode(firstPin + i, OUTPUT);
+    // Slot i toggles every 100 * (i + 1) milliseconds without drifting
+    bank.begin(i, 100 * (i + 1), TIMER_RUN_MODE_PERIODIC);
+  }
+}
+
+void loop() {
+  // One clock read and one pass over the bank.  Bit i of the result is 
+  // set if slot i expired.
+  const TimerBank<LED_COUNT>::MaskWord* due = bank.run();
+
+  for (uint8_t i = 0; i < LED_COUNT; i++) {
+    if (due[0] & (1UL << i)) {
+      ledState[i] = !ledState[i];
+      digitalWrite(firstPin + i, ledState[i]);
+    }
+  }
+}
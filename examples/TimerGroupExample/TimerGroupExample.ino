@@ -0,0 +1,49 @@
+#include <BasicTimer.h>
+
+// Forward declaration of our callback function
+void on_report();
+
+// A TimerGroup reads the clock once per loop and checks every member
+// against that one reading.  It can hold up to 8 members by default.
+TimerGroup<> group;
+
+BasicBlinker redBlinker(250);
+BasicBlinker greenBlinker(250);
+CallbackTimer reportTimer(1000, on_report, TIMER_RUN_MODE_CONTINUOUS);
+BasicTimer buttonTimer(50);
+
+void setup() {
+  Serial.begin(9600);
+  pinMode(2, OUTPUT);
+  pinMode(3, OUTPUT);
+
+  // Callback timers, blinkers and queues are run by the group
+  group.add(redBlinker);
+  group.add(greenBlinker);
+  group.add(reportTimer);
+
+  redBlinker.reset();
+  greenBlinker.reset();
+  reportTimer.start();
+  buttonTimer.reset();
+}
+
+void loop() {
+  // One clock read for every member.  Because both blinkers share the 
+  // same reading they will always toggle together.
+  group.run();
+
+  digitalWrite(2, redBlinker);
+  digitalWrite(3, greenBlinker);
+
+  // Plain timers can be checked against the same reading with now()
+  if (buttonTimer.hasExpired(group.now())) {
+    buttonTimer.reset(group.now());
+    digitalRead(4);
+  }
+}
+
+void on_report() {
+  Serial.print(F("Clock reading for this pass: "));
+  Serial.println(group.now());
+}
@@ -0,0 +1,58 @@
+#include <BasicTimer.h>
+
+// Eight timer slots shared by everything below.  Slots are borrowed with
+// after() and every() and given back when a timer fires or is cancelled.
+TimerPool<8> timers;
+
+// Handle of the pending retry, if any.  A stale handle is harmless: 
+// cancel() on a timer that already fired does nothing.
+TimerPool<8>::Handle retryTimer = TimerPool<8>::InvalidHandle;
+uint8_t attempts = 0;
+
+bool ledState = false;
+
+void sendPacket();
+void onAck();
+
+void blink() {
+  ledState = !ledState;
+  digitalWrite(LED_BUILTIN, ledState);
+}
+
+void sendPacket() {
+  attempts++;
+  Serial.print(F("sending packet, attempt "));
+  Serial.println(attempts);
+  if (attempts < 5) {
+    // Try again in 200ms unless an acknowledgement cancels the retry
+    retryTimer = timers.after(200, sendPacket);
+  } else {
+    Serial.println(F("giving up"));
+  }
+}
+
+void onAck() {
+  Serial.println(F("acknowledged"));
+  timers.cancel(retryTimer);
+}
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  // A periodic timer that runs for the life of the sketch
+  timers.every(500, blink);
+
+  // Send a packet now and pretend the acknowledgement arrives after 
+  // 700ms, during the fourth attempt
+  sendPacket();
+  timers.after(700, onAck);
+
+  // Lambdas that capture nothing, or a pointer or two, work too
+  timers.after(3000, []() { Serial.println(F("three seconds in")); });
+}
+
+void loop() {
+  // Runs every timer that has expired
+  timers.run();
+}
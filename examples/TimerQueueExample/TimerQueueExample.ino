@@ -0,0 +1,52 @@
+#include <BasicTimer.h>
+
+// Forward declaration of our callback functions
+void on_sample();
+void on_heartbeat();
+void doBulkWork();
+
+// A TimerQueue keeps its timers sorted by deadline, so it can tell us
+// how long we have until the next one is due without checking them all.
+TimerQueue queue;
+
+// QueuedTimers take the same arguments as a CallbackTimer: the timeout in
+// milliseconds, the callback and the run mode.
+QueuedTimer sampleTimer(100, on_sample, TIMER_RUN_MODE_CONTINUOUS);
+QueuedTimer heartbeatTimer(1000, on_heartbeat, TIMER_RUN_MODE_CONTINUOUS);
+
+unsigned long bulkWorkDone = 0;
+
+void setup() {
+  Serial.begin(9600);
+  // Timers are started and stopped through the queue
+  queue.start(sampleTimer);
+  queue.start(heartbeatTimer);
+}
+
+void loop() {
+  // Fire every timer that is due
+  queue.service();
+
+  // If nothing is due for a while we can get on with slow work.  
+  // timeUntilNext() returns the time in milliseconds until the 
+  // earliest timer expires.
+  if (queue.timeUntilNext() > 10) {
+    doBulkWork();
+  }
+}
+
+void doBulkWork() {
+  bulkWorkDone++;
+}
+
+void on_sample() {
+  analogRead(A0);
+}
+
+void on_heartbeat() {
+  Serial.print(F("Bulk work done: "));
+  Serial.println(bulkWorkDone);
+  // Every timer also knows its own deadline
+  Serial.print(F("Next sample due at: "));
+  Serial.println(sampleTimer.deadline());
+}
@@ -0,0 +1,44 @@
+// TimerService needs std::thread and std::atomic, so it is not part of 
+// BasicTimer.h.  It runs on ESP32 and Linux hosts only.
+#include <TimerService.h>
+
+// Forward declarations of our callback functions
+void on_blink();
+void on_timeout();
+
+// 8 timer slots, a 32 entry command queue, and callbacks run by 2 worker
+// threads instead of the dispatcher thread
+TimerService<8, 32> service(2);
+
+const uint16_t BLINK = 0;
+const uint16_t TIMEOUT = 1;
+
+volatile bool ledState = LOW;
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  // Starts the dispatcher and worker threads.  On a board without 
+  // std::thread, skip begin() and call service.run() from a loop instead.
+  service.begin();
+
+  service.arm(BLINK, 500, on_blink, TIMER_RUN_MODE_PERIODIC);
+}
+
+void loop() {
+  // arm() and cancel() are safe from any task or core.  Re-arming a slot
+  // restarts it, so this timeout only fires if loop() stops running.
+  service.arm(TIMEOUT, 2000, on_timeout);
+  delay(100);
+}
+
+void on_blink() {
+  ledState = !ledState;
+  digitalWrite(LED_BUILTIN, ledState);
+}
+
+void on_timeout() {
+  Serial.println(F("loop() has stalled"));
+  service.cancel(BLINK);
+}
@@ -0,0 +1,62 @@
+#include <BasicTimer.h>
+
+void serviceReminder();
+
+// A reminder every 8 hours that should not start over after every reset,
+// and a status blinker whose phase we may as well keep too
+CallbackTimer serviceTimer(8UL * 60 * 60 * 1000, serviceReminder, TIMER_RUN_MODE_PERIODIC);
+BasicBlinker statusBlinker(500);
+
+// Saves the state of both every minute
+BasicTimer saveTimer(60000);
+
+TimerSnapshot<2> snapshot;
+
+#if defined(__AVR__)
+// The snapshot lives in EEPROM, which survives a power cycle.  A 
+// RamTimerStorage in a .noinit section would survive watchdog and 
+// brownout resets without any EEPROM wear.
+EepromTimerStorage storage;
+#else
+RamTimerStorage<32> storage;
+#endif
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  // Register in the same order on every boot
+  snapshot.add(serviceTimer);
+  snapshot.add(statusBlinker);
+
+  // Restore as early as possible.  If there is no valid snapshot (first 
+  // boot, or the registered timers changed) start them fresh instead.
+  if (snapshot.restore(storage)) {
+    Serial.print(F("restored, next service reminder in "));
+    Serial.print(serviceTimer.timeRemaining(millis()) / 60000);
+    Serial.println(F(" minutes"));
+  } else {
+    Serial.println(F("no snapshot, starting fresh"));
+    serviceTimer.start();
+    statusBlinker.reset();
+  }
+  saveTimer.begin();
+}
+
+void loop() {
+  serviceTimer.run();
+  statusBlinker.run();
+  digitalWrite(LED_BUILTIN, statusBlinker ? HIGH : LOW);
+
+  if (saveTimer.hasExpired()) {
+    saveTimer.reset();
+    // Only bytes that changed are written to EEPROM, but saving every 
+    // minute still wears it out in a few months.  Save less often, or 
+    // on a power fail interrupt, in a real design.
+    snapshot.save(storage);
+  }
+}
+
+void serviceReminder() {
+  Serial.println(F("time for service"));
+}
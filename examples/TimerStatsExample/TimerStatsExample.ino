@@ -0,0 +1,50 @@
+#include <BasicTimer.h>
+
+bool ledState = LOW;
+
+void blink();
+void busyWork();
+void report();
+
+// A 100ms blink, a task that sometimes hogs loop(), and a report timer.
+// Only the first two keep lateness statistics; the report timer is a 
+// plain CallbackTimer and costs nothing extra.
+StatsCallbackTimer blinkTimer(100, blink, TIMER_RUN_MODE_PERIODIC);
+StatsCallbackTimer busyTimer(330, busyWork, TIMER_RUN_MODE_PERIODIC);
+CallbackTimer reportTimer(5000, report, TIMER_RUN_MODE_PERIODIC);
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+  blinkTimer.start();
+  busyTimer.start();
+  reportTimer.start();
+}
+
+void loop() {
+  blinkTimer.run();
+  busyTimer.run();
+  reportTimer.run();
+}
+
+void blink() {
+  ledState = !ledState;
+  digitalWrite(LED_BUILTIN, ledState);
+}
+
+void busyWork() {
+  // Simulate a slow sensor read.  While it runs, blinkTimer cannot be 
+  // serviced, which shows up as lateness in its statistics.
+  delay(random(0, 40));
+}
+
+void report() {
+  // Prints lines like
+  //   blink: fires=50 late min=0 mean=1 max=38 jitter mean=2 max=38 hist=[36 0 0 1 3 6 4 0]
+  Serial.print(F("blink: "));
+  blinkTimer.stats().printTo(Serial);
+  Serial.print(F("busy:  "));
+  busyTimer.stats().printTo(Serial);
+  blinkTimer.stats().clear();
+  busyTimer.stats().clear();
+}
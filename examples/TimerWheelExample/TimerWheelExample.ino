@@ -0,0 +1,60 @@
+#include <BasicTimer.h>
+
+// Storage Variable for our blinking LED
+bool ledState = LOW;
+
+// Forward declaration of our callback functions
+void on_blink();
+void on_report();
+void on_retry();
+
+// A TimerWheel schedules many timers from one service() call.  Instead of
+// calling run() on every timer, the wheel only looks at the timers whose
+// time has come, so it stays cheap with hundreds of timers.
+//
+// The default wheel has 4 levels of 16 slots with a 1ms tick.
+TimerWheel<> wheel;
+
+// WheelTimers take the same arguments as a CallbackTimer: the timeout in
+// milliseconds, the callback and the run mode.
+WheelTimer blinkTimer(250, on_blink, TIMER_RUN_MODE_CONTINUOUS);
+WheelTimer reportTimer(5000, on_report, TIMER_RUN_MODE_CONTINUOUS);
+WheelTimer retryTimer;
+
+void setup() {
+  Serial.begin(9600);
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, ledState);
+
+  // Sync the wheel to the current time before starting any timers
+  wheel.begin();
+
+  // Timers are started and stopped through the wheel
+  wheel.start(blinkTimer);
+  wheel.start(reportTimer);
+
+  // begin() sets the timeout and mode, then starts the timer
+  retryTimer.onExpire(on_retry);
+  wheel.begin(retryTimer, 1500, TIMER_RUN_MODE_ONE_SHOT);
+}
+
+void loop() {
+  // One call services every timer in the wheel
+  wheel.service();
+}
+
+void on_blink() {
+  ledState = !ledState;
+  digitalWrite(LED_BUILTIN, ledState);
+}
+
+void on_report() {
+  Serial.print(F("Timers waiting in the wheel: "));
+  Serial.println(wheel.pending());
+}
+
+void on_retry() {
+  // One shot timers can be restarted from inside their own callback
+  Serial.println(F("Retrying..."));
+  wheel.start(retryTimer);
+}
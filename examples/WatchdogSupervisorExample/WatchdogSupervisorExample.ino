@@ -0,0 +1,59 @@
+#include <BasicTimer.h>
+#if defined(__AVR__)
+#include <avr/wdt.h>
+#endif
+
+void onStarved(uint8_t channel);
+
+// Up to four supervised subsystems
+WatchdogSupervisor<4> supervisor(onStarved);
+uint8_t sensorChannel;
+uint8_t displayChannel;
+
+// The two "subsystems".  The sensor stops making progress after 10 
+// seconds to show a starved channel being reported.
+BasicTimer sensorTimer(100);
+BasicTimer displayTimer(250);
+
+void setup() {
+  Serial.begin(115200);
+  // The sensor must make progress at least every 500ms, the display 
+  // every 2 seconds
+  sensorChannel = supervisor.add(500);
+  displayChannel = supervisor.add(2000);
+  sensorTimer.begin();
+  displayTimer.begin();
+#if defined(__AVR__)
+  wdt_enable(WDTO_4S);
+#endif
+}
+
+void loop() {
+  if (sensorTimer.hasExpired() && millis() < 10000) {
+    sensorTimer.reset();
+    // ... read the sensor ...
+    supervisor.kick(sensorChannel);
+  }
+
+  if (displayTimer.hasExpired()) {
+    displayTimer.reset();
+    // ... redraw the display ...
+    supervisor.kick(displayChannel);
+  }
+
+  // Feed the hardware watchdog only while every subsystem is healthy.
+  // If one stays starved, the board resets in 4 seconds.
+  if (supervisor.check() == 0) {
+#if defined(__AVR__)
+    wdt_reset();
+#endif
+  }
+}
+
+void onStarved(uint8_t channel) {
+  Serial.print(F("subsystem "));
+  Serial.print(channel);
+  Serial.println(F(" starved"));
+  // A subsystem could be restarted here and kicked, instead of letting 
+  // the hardware watchdog reset the whole board
+}
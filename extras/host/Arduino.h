@@ -0,0 +1,276 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  Arduino.h
+//!  @brief Host side stand-in for the Arduino core with a virtual clock
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+#ifndef _BASIC_TIMER_HOST_ARDUINO_H_
+#define _BASIC_TIMER_HOST_ARDUINO_H_
+
+/*
+ *  Just enough of the Arduino core to build this library and its examples 
+ *  on a desktop machine.  Time comes from a virtual clock that only moves 
+ *  when it is told to, either by ArduinoHost::advanceMillis() and friends 
+ *  or by delay(), so time based code runs as fast as the host allows and 
+ *  gives the same result every time.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define LED_BUILTIN 13
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#define NUM_DIGITAL_PINS 20
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t*>(address))
+#define pgm_read_word(address) (*reinterpret_cast<const uint16_t*>(address))
+#define pgm_read_dword(address) (*reinterpret_cast<const uint32_t*>(address))
+#define pgm_read_ptr(address) (*reinterpret_cast<void* const*>(address))
+#define memcpy_P memcpy
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+namespace ArduinoHost 
+{
+    /**
+     * @brief The virtual clock in microseconds since the program started
+     */
+    inline uint64_t& clockMicros()
+    {
+        static uint64_t micros = 0;
+        return micros;
+    }
+
+    /**
+     * @brief Moves the virtual clock forward
+     * 
+     * @param duration The time to advance in microseconds
+     */
+    inline void advanceMicros(uint64_t duration) { clockMicros() += duration; }
+
+    /**
+     * @brief Moves the virtual clock forward
+     * 
+     * @param duration The time to advance in milliseconds
+     */
+    inline void advanceMillis(unsigned long duration) { clockMicros() += uint64_t(duration) * 1000; }
+
+    /**
+     * @brief Sets the virtual clock so that millis() returns the supplied 
+     *        value.  Useful for starting a test just before rollover.
+     * 
+     * @param timestamp The new millis() value
+     */
+    inline void setMillis(unsigned long timestamp) { clockMicros() = uint64_t(timestamp) * 1000; }
+
+    /**
+     * @brief TicklessIdle sleep hook that moves the virtual clock forward 
+     *        by the sleep time instead of waiting, so idle loops can be 
+     *        run and their wakes counted on the host
+     */
+    inline void idleSleep(unsigned long duration) { advanceMillis(duration); }
+
+    /**
+     * @brief Simulated pin levels, indexed by pin number
+     */
+    inline uint8_t* pinLevels()
+    {
+        static uint8_t levels[NUM_DIGITAL_PINS] = {0};
+        return levels;
+    }
+
+    /**
+     * @brief Simulated analog input values, indexed by pin number
+     */
+    inline int* analogValues()
+    {
+        static int values[NUM_DIGITAL_PINS] = {0};
+        return values;
+    }
+}
+
+inline unsigned long millis() { return static_cast<unsigned long>(static_cast<uint32_t>(ArduinoHost::clockMicros() / 1000)); }
+inline unsigned long micros() { return static_cast<unsigned long>(static_cast<uint32_t>(ArduinoHost::clockMicros())); }
+inline void delay(unsigned long duration) { ArduinoHost::advanceMillis(duration); }
+inline void delayMicroseconds(unsigned int duration) { ArduinoHost::advanceMicros(duration); }
+inline void yield() {}
+
+inline void interrupts() {}
+inline void noInterrupts() {}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t value) 
+{ 
+    if (pin < NUM_DIGITAL_PINS) ArduinoHost::pinLevels()[pin] = value ? HIGH : LOW; 
+}
+inline int digitalRead(uint8_t pin) 
+{ 
+    return (pin < NUM_DIGITAL_PINS) ? ArduinoHost::pinLevels()[pin] : LOW; 
+}
+inline int analogRead(uint8_t pin) 
+{ 
+    return (pin < NUM_DIGITAL_PINS) ? ArduinoHost::analogValues()[pin] : 0; 
+}
+inline void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value)
+{
+    for (uint8_t i = 0; i < 8; i++) {
+        digitalWrite(dataPin, (bitOrder == LSBFIRST) ? ((value >> i) & 1) : ((value >> (7 - i)) & 1));
+        digitalWrite(clockPin, HIGH);
+        digitalWrite(clockPin, LOW);
+    }
+}
+inline void randomSeed(unsigned long seed) { srand(static_cast<unsigned int>(seed)); }
+inline long random(long howBig) { return howBig > 0 ? rand() % howBig : 0; }
+inline long random(long howSmall, long howBig) 
+{ 
+    return (howSmall < howBig) ? howSmall + random(howBig - howSmall) : howSmall; 
+}
+
+/**
+ * @brief Minimal version of the Arduino Print class
+ */
+class Print
+{
+    public:
+        virtual ~Print() {}
+        virtual size_t write(uint8_t c) = 0;
+
+        size_t write(const char* str) { return write(reinterpret_cast<const uint8_t*>(str), strlen(str)); }
+        virtual size_t write(const uint8_t* buffer, size_t size)
+        {
+            size_t count = 0;
+            while (size--) count += write(*buffer++);
+            return count;
+        }
+
+        size_t print(const __FlashStringHelper* str) { return write(reinterpret_cast<const char*>(str)); }
+        size_t print(const char* str) { return write(str); }
+        size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+        size_t print(unsigned char value) { return print(static_cast<unsigned long>(value)); }
+        size_t print(int value) { return print(static_cast<long>(value)); }
+        size_t print(unsigned int value) { return print(static_cast<unsigned long>(value)); }
+        size_t print(long value) { return printFormatted("%ld", value); }
+        size_t print(unsigned long value) { return printFormatted("%lu", value); }
+        size_t print(long long value) { return printFormatted("%lld", value); }
+        size_t print(unsigned long long value) { return printFormatted("%llu", value); }
+        size_t print(double value, int digits = 2) { return printFormatted("%.*f", digits, value); }
+
+        size_t println() { return write("\r\n"); }
+        template <typename T>
+        size_t println(T value) { return print(value) + println(); }
+        size_t println(double value, int digits) { return print(value, digits) + println(); }
+
+    protected:
+        template <typename... Args>
+        size_t printFormatted(const char* format, Args... args)
+        {
+            char buffer[32];
+            int length = snprintf(buffer, sizeof(buffer), format, args...);
+            if (length < 0) return 0;
+            if (length >= static_cast<int>(sizeof(buffer))) length = sizeof(buffer) - 1;
+            return write(reinterpret_cast<const uint8_t*>(buffer), length);
+        }
+};
+
+/**
+ * @brief Serial port stand-in that writes to stdout
+ */
+class HardwareSerial: public Print
+{
+    public:
+        void begin(unsigned long) {}
+        void end() {}
+        void flush() { fflush(stdout); }
+        operator bool() const { return true; }
+
+        size_t write(uint8_t c) override { return (putchar(c) == EOF) ? 0 : 1; }
+        using Print::write;
+};
+
+static HardwareSerial Serial;
+
+#endif /* _BASIC_TIMER_HOST_ARDUINO_H_ */
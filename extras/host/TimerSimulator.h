@@ -0,0 +1,150 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerSimulator.h
+//!  @brief Virtual time simulator for host builds
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+#ifndef _BASIC_TIMER_HOST_TIMER_SIMULATOR_H_
+#define _BASIC_TIMER_HOST_TIMER_SIMULATOR_H_
+
+#include <Arduino.h>
+#include <BasicTimer.h>
+
+/**
+ * @brief Discrete event simulator that drives the library's timers 
+ *        against the host virtual clock.
+ * 
+ *    A TimerSimulator is a TicklessIdle whose sleep is a jump of the 
+ *    virtual clock, so register timers, blinkers and queues with add() 
+ *    exactly as with TicklessIdle.  runFor() then moves time straight to 
+ *    each deadline instead of stepping through every millisecond, running 
+ *    the registered objects and an optional step function (usually the 
+ *    body of loop()) at every event.  Days of simulated time with millions
+ *    of expiries take milliseconds to run.
+ * 
+ * @tparam CAPACITY The maximum number of registered objects
+ */
+template <uint8_t CAPACITY = 16>
+class TimerSimulator: public TicklessIdle<CAPACITY>
+{
+    public:
+        /**
+         * @brief Step function type, called once per simulated event
+         */
+        typedef void(*StepFunction)();
+
+        /**
+         * @brief Construct a new TimerSimulator
+         */
+        TimerSimulator(): TicklessIdle<CAPACITY>(&ArduinoHost::advanceMillis), eventCounter(0)
+        {
+            this->setSleepLimits(1, BasicTimer::NoDeadline);
+        };
+
+        /**
+         * @brief Runs the simulation for the supplied amount of virtual time
+         * 
+         *        The registered objects and the step function are run at 
+         *        the start, at every deadline and once more at the end.  
+         *        If something stays due after it has been run (a plain 
+         *        BasicTimer that step() does not reset, for example) the 
+         *        clock moves forward 1 ms at a time.
+         * 
+         * @param duration The time to simulate in milliseconds
+         * @param step Function to run at every event, or nullptr
+         */
+        void runFor(unsigned long duration, StepFunction step = nullptr)
+        {
+            unsigned long remaining = duration;
+            while (true) {
+                this->service();
+                if (step != nullptr) step();
+                eventCounter++;
+                if (remaining == 0) break;
+
+                unsigned long next = this->timeUntilNext();
+                if (next == 0) next = 1;
+                if (next > remaining) next = remaining;
+                ArduinoHost::advanceMillis(next);
+                remaining -= next;
+            }
+        }
+
+        /**
+         * @brief Runs the simulation until millis() reaches the supplied 
+         *        timestamp, which may be past the millis() rollover.
+         * 
+         * @param timestamp The millis() value to stop at
+         * @param step Function to run at every event, or nullptr
+         */
+        void runUntil(unsigned long timestamp, StepFunction step = nullptr)
+        {
+            // millis() is 32 bits even where unsigned long is 64, so the 
+            // distance to a timestamp past the rollover must wrap at 32 bits
+            runFor(static_cast<uint32_t>(timestamp - millis()), step);
+        }
+
+        /**
+         * @brief The number of events simulated so far
+         * 
+         * @return unsigned long long 
+         */
+        unsigned long long events() const { return eventCounter; };
+
+    protected:
+        unsigned long long eventCounter;
+};
+
+#endif /* _BASIC_TIMER_HOST_TIMER_SIMULATOR_H_ */
@@ -0,0 +1,113 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  ClockBenchmark.cpp
+//!  @brief Per check cost of each clock policy
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+#include <Arduino.h>
+#include <BasicTimer.h>
+#include <SteadyClock.h>
+#include <stdlib.h>
+
+/*
+ *  Measures the cost of one hasExpired() check for TBasicTimer and 
+ *  TStaticTimer with each clock policy available on the host.  Output is
+ *  one CSV line per case: class,clock,ns_per_check,sizeof
+ * 
+ *  Note that MillisClock and MicrosClock read the host virtual clock here, 
+ *  so they only show the overhead of the timer itself.  Run the same loop 
+ *  on a board for the cost of the real millis() and micros().
+ */
+
+static volatile unsigned long sink = 0;
+
+// Stops the compiler from hoisting the clock read out of the loop
+static inline void clobberMemory() { asm volatile("" : : : "memory"); }
+
+template <typename Timer>
+static double nanosecondsPerCheck(unsigned long iterations)
+{
+    Timer timer;
+    timer.reset();
+    unsigned long expired = 0;
+    SteadyClock::TickType start = SteadyClock::now();
+    for (unsigned long i = 0; i < iterations; i++) {
+        expired += timer.hasExpired();
+        clobberMemory();
+    }
+    SteadyClock::TickType finish = SteadyClock::now();
+    sink += expired;
+    return static_cast<double>(finish - start) / iterations;
+}
+
+template <typename Timer>
+static void report(const char* className, const char* clockName, unsigned long iterations)
+{
+    double cost = nanosecondsPerCheck<Timer>(iterations);
+    printf("%s,%s,%.3f,%u\n", className, clockName, cost, static_cast<unsigned>(sizeof(Timer)));
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long iterations = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000UL;
+    printf("class,clock,ns_per_check,sizeof\n");
+    report<TBasicTimer<MillisClock>>("TBasicTimer", "MillisClock", iterations);
+    report<TBasicTimer<MicrosClock>>("TBasicTimer", "MicrosClock", iterations);
+    report<TBasicTimer<SteadyClock>>("TBasicTimer", "SteadyClock", iterations);
+    report<TStaticTimer<500, MillisClock>>("TStaticTimer", "MillisClock", iterations);
+    report<TStaticTimer<500, MicrosClock>>("TStaticTimer", "MicrosClock", iterations);
+    report<TStaticTimer<500, SteadyClock>>("TStaticTimer", "SteadyClock", iterations);
+    return 0;
+}
@@ -0,0 +1,119 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  DelegateBenchmark.cpp
+//!  @brief Dispatch cost and size of each TimerDelegate target
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <BasicTimer.h>
+#include <SteadyClock.h>
+#include <stdlib.h>
+
+/*
+ *  Measures the cost of calling each kind of TimerDelegate target, against
+ *  calling a plain function pointer.  Output is one CSV line per case:
+ *  target,ns_per_call,sizeof
+ */
+
+static volatile unsigned long sink = 0;
+static unsigned long counter = 0;
+
+// Forces the callable to be reloaded from memory on every call, as it 
+// would be from a timer
+static inline void clobberMemory() { asm volatile("" : : : "memory"); }
+
+static void countCall() { counter++; }
+static void countCallWithContext(void* context) { (*static_cast<unsigned long*>(context))++; }
+
+struct Counter
+{
+    unsigned long calls;
+    void count() { calls++; }
+};
+
+template <typename Callable>
+static void report(const char* target, Callable& callable, unsigned long iterations)
+{
+    counter = 0;
+    SteadyClock::TickType start = SteadyClock::now();
+    for (unsigned long i = 0; i < iterations; i++) {
+        callable();
+        clobberMemory();
+    }
+    SteadyClock::TickType finish = SteadyClock::now();
+    sink += counter;
+    printf("%s,%.3f,%u\n", target, static_cast<double>(finish - start) / iterations, 
+           static_cast<unsigned>(sizeof(Callable)));
+}
+
+static void (*plainFunction)() = countCall;
+static TimerDelegate functionDelegate(countCall);
+static TimerDelegate contextDelegate(countCallWithContext, &counter);
+static Counter counterObject = {0};
+static TimerDelegate methodDelegate = TimerDelegate::bind<Counter, &Counter::count>(&counterObject);
+
+int main(int argc, char** argv)
+{
+    unsigned long iterations = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000UL;
+    unsigned long* count = &counter;
+    TimerDelegate lambdaDelegate([count]() { (*count)++; });
+
+    printf("target,ns_per_call,sizeof\n");
+    report("function pointer", plainFunction, iterations);
+    report("TimerDelegate function", functionDelegate, iterations);
+    report("TimerDelegate context", contextDelegate, iterations);
+    report("TimerDelegate method", methodDelegate, iterations);
+    report("TimerDelegate lambda", lambdaDelegate, iterations);
+    return 0;
+}
@@ -0,0 +1,219 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  InterruptLatencyBenchmark.cpp
+//!  @brief Dispatch latency and ring overflow of InterruptTimers
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <BasicTimer.h>
+#include <SteadyClock.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*
+ *  Drives an InterruptTimers set from a real 1 ms tick on a Linux host and
+ *  measures how long each expiry waits in the ring before its callback 
+ *  runs, while loop() spends a random amount of time busy between 
+ *  dispatch() calls.  The tick comes from a POSIX interval timer signal 
+ *  (which interrupts the loop thread like a hardware interrupt) or from a 
+ *  separate thread.  Output is one CSV line per case:
+ *  source,busy_us,expiries,p50_us,p99_us,max_us,overflows
+ * 
+ *  Build with: g++ -std=gnu++11 -O2 -pthread ... -lrt
+ */
+
+static const unsigned long TickMicros = 1000;
+static const uint8_t TimerCount = 8;
+static const unsigned int TickHistory = 4096;
+
+static InterruptTimers<TimerCount, 16> timers;
+static SteadyClock::TickType tickTimes[TickHistory];
+static unsigned long hostTicks = 0;
+static std::vector<double> latencies;
+
+// The "interrupt": remember when each tick happened, then run the timers
+static void onTick()
+{
+    hostTicks++;
+    tickTimes[hostTicks % TickHistory] = SteadyClock::now();
+    timers.tick();
+}
+
+static void onSignal(int) { onTick(); }
+
+static void recordLatency()
+{
+    SteadyClock::TickType expired = tickTimes[timers.expiredAt() % TickHistory];
+    latencies.push_back(static_cast<double>(SteadyClock::now() - expired) / 1000.0);
+}
+
+static void busyFor(unsigned long micros)
+{
+    SteadyClock::TickType finish = SteadyClock::now() + static_cast<SteadyClock::TickType>(micros) * 1000;
+    while (SteadyClock::now() < finish) {}
+}
+
+class SignalTickSource
+{
+    public:
+        SignalTickSource()
+        {
+            struct sigaction action;
+            memset(&action, 0, sizeof(action));
+            action.sa_handler = onSignal;
+            action.sa_flags = SA_RESTART;
+            sigaction(SIGRTMIN, &action, nullptr);
+
+            struct sigevent event;
+            memset(&event, 0, sizeof(event));
+            event.sigev_notify = SIGEV_SIGNAL;
+            event.sigev_signo = SIGRTMIN;
+            timer_create(CLOCK_MONOTONIC, &event, &timer);
+
+            struct itimerspec interval;
+            interval.it_interval.tv_sec = 0;
+            interval.it_interval.tv_nsec = TickMicros * 1000;
+            interval.it_value = interval.it_interval;
+            timer_settime(timer, 0, &interval, nullptr);
+        }
+
+        ~SignalTickSource() { timer_delete(timer); }
+
+    private:
+        timer_t timer;
+};
+
+class ThreadTickSource
+{
+    public:
+        ThreadTickSource(): running(true), worker(&ThreadTickSource::run, this) {}
+
+        ~ThreadTickSource()
+        {
+            running = false;
+            worker.join();
+        }
+
+    private:
+        std::atomic<bool> running;
+        std::thread worker;
+
+        void run()
+        {
+            std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+            while (running) {
+                next += std::chrono::microseconds(TickMicros);
+                std::this_thread::sleep_until(next);
+                onTick();
+            }
+        }
+};
+
+static double percentile(std::vector<double>& values, double fraction)
+{
+    if (values.empty()) return 0;
+    size_t index = static_cast<size_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+template <typename TickSource>
+static void measure(const char* source, unsigned long busyMicros, unsigned long durationMillis)
+{
+    latencies.clear();
+    latencies.reserve(durationMillis * TimerCount);
+    unsigned long overflowsBefore = timers.overflows();
+    for (uint8_t i = 0; i < TimerCount; i++) {
+        timers.start(i, i + 1, TIMER_RUN_MODE_PERIODIC);
+    }
+    {
+        TickSource tickSource;
+        SteadyClock::TickType finish = SteadyClock::now() + static_cast<SteadyClock::TickType>(durationMillis) * 1000000;
+        while (SteadyClock::now() < finish) {
+            timers.dispatch();
+            if (busyMicros > 0) busyFor(rand() % (busyMicros + 1));
+        }
+    }
+    for (uint8_t i = 0; i < TimerCount; i++) {
+        timers.stop(i);
+    }
+    onTick();
+    timers.dispatch();
+    printf("%s,%lu,%u,%.1f,%.1f,%.1f,%lu\n", source, busyMicros, static_cast<unsigned>(latencies.size()),
+           percentile(latencies, 0.5), percentile(latencies, 0.99), percentile(latencies, 1.0),
+           timers.overflows() - overflowsBefore);
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long durationMillis = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000UL;
+    for (uint8_t i = 0; i < TimerCount; i++) {
+        timers.onExpire(i, recordLatency);
+    }
+    const unsigned long busyCases[] = {0, 500, 2000, 10000};
+    printf("source,busy_us,expiries,p50_us,p99_us,max_us,overflows\n");
+    for (unsigned long busy : busyCases) {
+        measure<SignalTickSource>("signal", busy, durationMillis);
+    }
+    for (unsigned long busy : busyCases) {
+        measure<ThreadTickSource>("thread", busy, durationMillis);
+    }
+    return 0;
+}
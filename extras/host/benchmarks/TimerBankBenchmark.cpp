@@ -0,0 +1,150 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerBankBenchmark.cpp
+//!  @brief TimerBank scan cost against an array of CallbackTimers
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <BasicTimer.h>
+#include <SteadyClock.h>
+#include <stdlib.h>
+
+/*
+ *  Runs N continuous timers with timeouts spread over 1 to 1000 ms for a 
+ *  number of simulated milliseconds, once as an array of CallbackTimers 
+ *  each polled with run() and once as a TimerBank<N> scanned with one 
+ *  run().  Output is one CSV line per case: 
+ *  impl,timers,ns_per_pass,ns_per_timer,expiries,bytes
+ * 
+ *  Both cases should report the same number of expiries.
+ */
+
+static unsigned long callbackCount = 0;
+static void countExpiry() { callbackCount++; }
+
+// Stops the compiler from hoisting the clock read out of the loop
+static inline void clobberMemory() { asm volatile("" : : : "memory"); }
+
+static unsigned long timeoutFor(unsigned long slot) { return 1 + (slot * 7919UL) % 1000; }
+
+static void report(const char* impl, unsigned long timers, SteadyClock::TickType elapsed, 
+                   unsigned long passes, unsigned long expiries, unsigned long bytes)
+{
+    double perPass = static_cast<double>(elapsed) / passes;
+    printf("%s,%lu,%.1f,%.3f,%lu,%lu\n", impl, timers, perPass, perPass / timers, expiries, bytes);
+}
+
+template <uint16_t N>
+static void benchmarkCallbackTimers(unsigned long passes)
+{
+    static CallbackTimer timers[N];
+    ArduinoHost::setMillis(0);
+    for (uint16_t i = 0; i < N; i++) {
+        timers[i].begin(timeoutFor(i), TIMER_RUN_MODE_CONTINUOUS);
+        timers[i].onExpire(countExpiry);
+    }
+    callbackCount = 0;
+    SteadyClock::TickType start = SteadyClock::now();
+    for (unsigned long pass = 0; pass < passes; pass++) {
+        ArduinoHost::advanceMillis(1);
+        BasicTimer::TickType current = BasicTimer::now();
+        for (uint16_t i = 0; i < N; i++) {
+            timers[i].run(current);
+        }
+        clobberMemory();
+    }
+    SteadyClock::TickType finish = SteadyClock::now();
+    report("CallbackTimer", N, finish - start, passes, callbackCount, sizeof(timers));
+}
+
+template <uint16_t N>
+static void benchmarkTimerBank(unsigned long passes)
+{
+    typedef TimerBank<N> Bank;
+    static Bank bank;
+    ArduinoHost::setMillis(0);
+    for (uint16_t i = 0; i < N; i++) {
+        bank.begin(i, timeoutFor(i), TIMER_RUN_MODE_CONTINUOUS);
+    }
+    unsigned long expiries = 0;
+    SteadyClock::TickType start = SteadyClock::now();
+    for (unsigned long pass = 0; pass < passes; pass++) {
+        ArduinoHost::advanceMillis(1);
+        const typename Bank::MaskWord* due = bank.run();
+        for (uint16_t w = 0; w < Bank::MaskWords; w++) {
+            expiries += __builtin_popcountl(due[w]);
+        }
+        clobberMemory();
+    }
+    SteadyClock::TickType finish = SteadyClock::now();
+    report("TimerBank", N, finish - start, passes, expiries, sizeof(bank));
+}
+
+template <uint16_t N>
+static void compare(unsigned long passes)
+{
+    benchmarkCallbackTimers<N>(passes);
+    benchmarkTimerBank<N>(passes);
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long passes = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 20000UL;
+    printf("impl,timers,ns_per_pass,ns_per_timer,expiries,bytes\n");
+    compare<16>(passes);
+    compare<100>(passes);
+    compare<1024>(passes);
+    compare<4096>(passes);
+    return 0;
+}
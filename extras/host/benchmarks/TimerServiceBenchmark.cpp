@@ -0,0 +1,142 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerServiceBenchmark.cpp
+//!  @brief Arm and cancel throughput of TimerService under contention
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <TimerService.h>
+#include <SteadyClock.h>
+#include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*
+ *  Several producer threads arm and cancel random slots of one 
+ *  TimerService as fast as they can while its dispatcher thread (and 
+ *  optionally worker threads) run the callbacks.  Output is one CSV line 
+ *  per case: producers,workers,requests,requests_per_sec,rejected,callbacks
+ * 
+ *  rejected counts arm()/cancel() calls that found the command queue full;
+ *  the producer yields and retries them.
+ * 
+ *  Build with: g++ -std=gnu++11 -O2 -pthread ...
+ */
+
+typedef TimerService<64, 256, SteadyClock> Service;
+
+static std::atomic<unsigned long> callbackCount(0);
+static void countCallback() { callbackCount.fetch_add(1, std::memory_order_relaxed); }
+
+static void produce(Service& service, unsigned long requests, unsigned int seed, std::atomic<unsigned long>& rejected)
+{
+    unsigned long localRejected = 0;
+    for (unsigned long i = 0; i < requests; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint16_t slot = (seed >> 8) % 64;
+        bool armed;
+        do {
+            if (i & 1) {
+                armed = service.cancel(slot);
+            } else {
+                Service::TickType timeout = 100000 + (seed >> 4) % 2000000;  // 0.1 to 2.1 ms
+                armed = service.arm(slot, timeout, countCallback, static_cast<TimerRunMode>(seed & 0x3));
+            }
+            if (!armed) {
+                localRejected++;
+                std::this_thread::yield();
+            }
+        } while (!armed);
+    }
+    rejected += localRejected;
+}
+
+static void measure(unsigned int producers, uint8_t workers, unsigned long requestsPerProducer)
+{
+    Service service(workers);
+    service.begin();
+    callbackCount = 0;
+    std::atomic<unsigned long> rejected(0);
+    std::vector<std::thread> threads;
+
+    SteadyClock::TickType start = SteadyClock::now();
+    for (unsigned int p = 0; p < producers; p++) {
+        threads.push_back(std::thread(produce, std::ref(service), requestsPerProducer, p + 1, std::ref(rejected)));
+    }
+    for (size_t p = 0; p < threads.size(); p++) {
+        threads[p].join();
+    }
+    SteadyClock::TickType finish = SteadyClock::now();
+    service.end();
+
+    unsigned long requests = producers * requestsPerProducer;
+    double seconds = static_cast<double>(finish - start) / 1e9;
+    printf("%u,%u,%lu,%.0f,%lu,%lu\n", producers, static_cast<unsigned>(workers), requests, 
+           requests / seconds, rejected.load(), callbackCount.load());
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long requestsPerProducer = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 200000UL;
+    const unsigned int producerCases[] = {1, 2, 4, 8};
+    printf("producers,workers,requests,requests_per_sec,rejected,callbacks\n");
+    for (unsigned int producers : producerCases) {
+        measure(producers, 0, requestsPerProducer);
+    }
+    for (unsigned int producers : producerCases) {
+        measure(producers, 4, requestsPerProducer);
+    }
+    return 0;
+}
@@ -0,0 +1,202 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerSuiteBenchmark.cpp
+//!  @brief Per-call cost and size of every timer class
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <BasicTimer.h>
+#include <SteadyClock.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ *  Times the call each class is polled with from loop() over 1 to 10,000
+ *  instances, then lists sizeof for every class in the library.  Output 
+ *  is CSV with one header: class,operation,instances,ns_per_op,bytes
+ *  The sizeof rows have operation "sizeof" and an empty ns_per_op.  Save 
+ *  the output of two library versions and diff or join on the first three
+ *  columns to compare them.
+ * 
+ *  Timing runs on the host virtual clock, which moves 1 ms between passes
+ *  over the instances.  Timeouts are 20 ms and the instances are started 
+ *  1 ms apart, so about one call in twenty takes the expiry path, as it 
+ *  would with a fast loop().  Timers that do not reset themselves are 
+ *  reset when they expire, the way a sketch uses them.
+ * 
+ *      ./TimerSuiteBenchmark [operations per case]
+ */
+
+static volatile unsigned long sink = 0;
+static unsigned long callbackCount = 0;
+static void countExpiry() { callbackCount++; }
+
+// Stops the compiler from hoisting the clock read out of the loop
+static inline void clobberMemory() { asm volatile("" : : : "memory"); }
+
+static const unsigned long TimeoutMs = 20;
+
+template <typename T, typename Make, typename Operation>
+static double nanosecondsPerOperation(size_t instances, unsigned long operations, 
+                                      Make make, Operation operation)
+{
+    std::vector<T> timers;
+    timers.reserve(instances);
+    for (size_t i = 0; i < instances; i++) {
+        ArduinoHost::setMillis(i % TimeoutMs);
+        timers.push_back(make());
+    }
+    ArduinoHost::setMillis(TimeoutMs);
+
+    unsigned long passes = operations / instances;
+    if (passes == 0) passes = 1;
+    unsigned long result = 0;
+    SteadyClock::TickType start = SteadyClock::now();
+    for (unsigned long pass = 0; pass < passes; pass++) {
+        for (size_t i = 0; i < instances; i++) {
+            result += operation(timers[i]);
+            clobberMemory();
+        }
+        ArduinoHost::advanceMillis(1);
+    }
+    SteadyClock::TickType finish = SteadyClock::now();
+    sink += result;
+    return static_cast<double>(finish - start) / (static_cast<double>(passes) * instances);
+}
+
+template <typename T, typename Make, typename Operation>
+static void report(const char* className, const char* operationName, 
+                   unsigned long operations, Make make, Operation operation)
+{
+    static const size_t Counts[] = {1, 10, 100, 1000, 10000};
+    for (size_t count : Counts) {
+        double cost = nanosecondsPerOperation<T>(count, operations, make, operation);
+        printf("%s,%s,%u,%.3f,%u\n", className, operationName, static_cast<unsigned>(count), 
+               cost, static_cast<unsigned>(sizeof(T)));
+    }
+}
+
+template <typename T>
+static void reportSize(const char* className)
+{
+    printf("%s,sizeof,1,,%u\n", className, static_cast<unsigned>(sizeof(T)));
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long operations = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000UL;
+    printf("class,operation,instances,ns_per_op,bytes\n");
+
+    report<BasicTimer>("BasicTimer", "hasExpired", operations,
+        []() { BasicTimer t(TimeoutMs); t.reset(); return t; },
+        [](BasicTimer& t) { bool expired = t.hasExpired(); if (expired) t.reset(); return expired; });
+    report<StaticTimer<TimeoutMs>>("StaticTimer", "hasExpired", operations,
+        []() { StaticTimer<TimeoutMs> t; t.reset(); return t; },
+        [](StaticTimer<TimeoutMs>& t) { bool expired = t.hasExpired(); if (expired) t.reset(); return expired; });
+    report<SwitchableTimer>("SwitchableTimer", "hasFinished", operations,
+        []() { SwitchableTimer t(TimeoutMs); t.enable(); return t; },
+        [](SwitchableTimer& t) { bool finished = t.hasFinished(); if (finished) t.reset(); return finished; });
+    report<CallbackTimer>("CallbackTimer", "run(continuous)", operations,
+        []() { CallbackTimer t(TimeoutMs, countExpiry, TIMER_RUN_MODE_CONTINUOUS); t.start(); return t; },
+        [](CallbackTimer& t) { return t.run(); });
+    report<CallbackTimer>("CallbackTimer", "run(periodic)", operations,
+        []() { CallbackTimer t(TimeoutMs, countExpiry, TIMER_RUN_MODE_PERIODIC); t.start(); return t; },
+        [](CallbackTimer& t) { return t.run(); });
+    report<DelegateTimer>("DelegateTimer", "run(continuous)", operations,
+        []() { DelegateTimer t(TimeoutMs, countExpiry, TIMER_RUN_MODE_CONTINUOUS); t.start(); return t; },
+        [](DelegateTimer& t) { return t.run(); });
+    report<BasicBlinker>("BasicBlinker", "update", operations,
+        []() { BasicBlinker b(TimeoutMs); b.reset(); return b; },
+        [](BasicBlinker& b) { return b.update(); });
+    report<StaticBlinker<TimeoutMs>>("StaticBlinker", "update", operations,
+        []() { StaticBlinker<TimeoutMs> b; b.reset(); return b; },
+        [](StaticBlinker<TimeoutMs>& b) { return b.update(); });
+    report<SwitchableBlinker>("SwitchableBlinker", "update", operations,
+        []() { SwitchableBlinker b(TimeoutMs); b.reset(); b.enable(); return b; },
+        [](SwitchableBlinker& b) { return b.update(); });
+
+    reportSize<BasicTimer>("BasicTimer");
+    reportSize<StaticTimer<TimeoutMs>>("StaticTimer");
+    reportSize<CompactTimer<uint16_t>>("CompactTimer<uint16_t>");
+    reportSize<CompactStaticTimer<TimeoutMs, uint16_t>>("CompactStaticTimer<uint16_t>");
+    reportSize<SwitchableTimer>("SwitchableTimer");
+    reportSize<CallbackTimer>("CallbackTimer");
+    reportSize<DelegateTimer>("DelegateTimer");
+    reportSize<TimerDelegate>("TimerDelegate");
+    reportSize<BasicBlinker>("BasicBlinker");
+    reportSize<StaticBlinker<TimeoutMs>>("StaticBlinker");
+    reportSize<SwitchableBlinker>("SwitchableBlinker");
+    reportSize<PatternBlinker>("PatternBlinker");
+    reportSize<BlinkerBank<8>>("BlinkerBank<8>");
+    reportSize<BlinkerGroup<8>>("BlinkerGroup<8>");
+    reportSize<TimerBank<32>>("TimerBank<32>");
+    reportSize<QueuedTimer>("QueuedTimer");
+    reportSize<TimerQueue>("TimerQueue");
+    reportSize<WheelTimer>("WheelTimer");
+    reportSize<TimerWheel<>>("TimerWheel<>");
+    reportSize<TimerPool<8>>("TimerPool<8>");
+    reportSize<WatchdogSupervisor<8>>("WatchdogSupervisor<8>");
+    reportSize<TimerGroup<8>>("TimerGroup<8>");
+    reportSize<TicklessIdle<8>>("TicklessIdle<8>");
+    reportSize<TimedStateMachine>("TimedStateMachine");
+    reportSize<InterruptTimers<>>("InterruptTimers<>");
+    reportSize<LoopMonitor>("LoopMonitor");
+    reportSize<DebounceBank<8>>("DebounceBank<8>");
+    reportSize<DebounceBank<32>>("DebounceBank<32>");
+    reportSize<TimerSnapshot<8>>("TimerSnapshot<8>");
+    reportSize<TokenBucket>("TokenBucket");
+    reportSize<LeakyBucket>("LeakyBucket");
+    reportSize<TimerStats>("TimerStats");
+    return 0;
+}
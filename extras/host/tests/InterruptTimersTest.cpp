@@ -0,0 +1,150 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  InterruptTimersTest.cpp
+//!  @brief Checks InterruptTimers repeat periods against CallbackTimer
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <InterruptTimers.h>
+#include <CallbackTimer.h>
+#include "HostTest.h"
+
+/*
+ *  Calls tick() once per millisecond, the way a 1 kHz timer interrupt 
+ *  would, next to a CallbackTimer run every millisecond, and checks that 
+ *  both expire on the same ticks in every repeating mode.
+ */
+
+static const unsigned MaxFires = 32;
+
+struct FireLog
+{
+    unsigned long times[MaxFires];
+    unsigned count = 0;
+
+    void add(unsigned long time)
+    {
+        if (count < MaxFires) times[count] = time;
+        count++;
+    }
+};
+
+static FireLog interruptLog;
+static FireLog callbackLog;
+static InterruptTimers<>* timers;
+static void onInterrupt() { interruptLog.add(timers->expiredAt()); }
+static void onCallback() { callbackLog.add(millis()); }
+
+static bool sameFires()
+{
+    if (interruptLog.count != callbackLog.count) return false;
+    for (unsigned i = 0; i < interruptLog.count && i < MaxFires; i++) {
+        if (interruptLog.times[i] != callbackLog.times[i]) return false;
+    }
+    return true;
+}
+
+static void compare(unsigned long timeout, TimerRunMode mode, unsigned long duration)
+{
+    interruptLog = FireLog();
+    callbackLog = FireLog();
+    ArduinoHost::setMillis(0);
+
+    // Tick n happens at n ms, so expiredAt() is comparable to millis()
+    InterruptTimers<> interruptTimers;
+    timers = &interruptTimers;
+    CallbackTimer callbackTimer(timeout, onCallback, mode);
+    interruptTimers.onExpire(0, onInterrupt);
+    interruptTimers.start(0, timeout, mode);
+    callbackTimer.start();
+
+    for (unsigned long ms = 1; ms <= duration; ms++) {
+        ArduinoHost::setMillis(ms);
+        interruptTimers.tick();
+        interruptTimers.dispatch();
+        callbackTimer.run();
+    }
+    CHECK_EQUAL(0, interruptTimers.overflows());
+}
+
+int main()
+{
+    // Continuous restarts from the expiry: every T + 1 ticks
+    compare(10, TIMER_RUN_MODE_CONTINUOUS, 100);
+    CHECK_EQUAL(9, interruptLog.count);
+    CHECK_EQUAL(11, interruptLog.times[0]);
+    CHECK_EQUAL(22, interruptLog.times[1]);
+    CHECK(sameFires());
+
+    // Periodic keeps the phase: every T ticks
+    compare(10, TIMER_RUN_MODE_PERIODIC, 100);
+    CHECK_EQUAL(9, interruptLog.count);
+    CHECK_EQUAL(11, interruptLog.times[0]);
+    CHECK_EQUAL(21, interruptLog.times[1]);
+    CHECK(sameFires());
+
+    compare(10, TIMER_RUN_MODE_PERIODIC_CATCH_UP, 100);
+    CHECK(sameFires());
+
+    // A zero timeout fires on every tick in every repeating mode
+    compare(0, TIMER_RUN_MODE_CONTINUOUS, 20);
+    CHECK_EQUAL(20, interruptLog.count);
+    CHECK(sameFires());
+
+    compare(0, TIMER_RUN_MODE_PERIODIC, 20);
+    CHECK_EQUAL(20, interruptLog.count);
+    CHECK(sameFires());
+
+    return testResult();
+}
@@ -0,0 +1,127 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  RateLimiterTest.cpp
+//!  @brief Checks TokenBucket and LeakyBucket refill, including after long idle periods
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <RateLimiter.h>
+#include "HostTest.h"
+
+int main()
+{
+    ArduinoHost::setMillis(1000);
+
+    // Bursts of 3, then 1 token per 100 ms
+    TokenBucket tokens(3, 1, 100);
+    CHECK(tokens.tryAcquire(3));
+    CHECK(!tokens.tryAcquire());
+    CHECK_EQUAL(100, tokens.timeUntilAvailable());
+    CHECK_EQUAL(TokenBucket::NoDeadline, tokens.timeUntilAvailable(4));
+    ArduinoHost::advanceMillis(150);
+    CHECK_EQUAL(1, tokens.available());
+    CHECK_EQUAL(50, tokens.timeUntilAvailable(2));
+
+    // One unit per 50 ms with a burst of 2
+    LeakyBucket leaky(50, 2);
+    CHECK(leaky.tryAcquire());
+    CHECK(leaky.tryAcquire());
+    CHECK(!leaky.tryAcquire());
+    CHECK_EQUAL(50, leaky.timeUntilAvailable());
+    ArduinoHost::advanceMillis(50);
+    CHECK(leaky.tryAcquire());
+    CHECK(!leaky.tryAcquire());
+
+    // Idle for 30 days, past half the millis() range
+    tokens.drain();
+    ArduinoHost::advanceMillis(30UL * 24 * 60 * 60 * 1000);
+    CHECK_EQUAL(3, tokens.available());
+    CHECK_EQUAL(0, leaky.timeUntilEmpty(millis()));
+    CHECK(leaky.tryAcquire(2));
+
+    // Idle for 40 minutes, past half the micros() range
+    TTokenBucket<MicrosClock> fastTokens(4, 1, 1000);
+    TLeakyBucket<MicrosClock> fastLeaky(1000, 4);
+    CHECK(fastTokens.tryAcquire(4));
+    CHECK(fastLeaky.tryAcquire(4));
+    CHECK(!fastTokens.tryAcquire());
+    CHECK(!fastLeaky.tryAcquire());
+    ArduinoHost::advanceMicros(40UL * 60 * 1000000);
+    CHECK_EQUAL(4, fastTokens.available());
+    CHECK_EQUAL(0, fastLeaky.timeUntilAvailable(4));
+    CHECK(fastLeaky.tryAcquire(4));
+
+    // A bucket without refill never fills up again
+    TokenBucket once(2, 0, 100);
+    CHECK(once.tryAcquire(2));
+    ArduinoHost::advanceMillis(1000);
+    CHECK_EQUAL(0, once.available());
+    CHECK_EQUAL(TokenBucket::NoDeadline, once.timeUntilAvailable());
+
+    // 1000 * 66 wraps a 16 bit level, the request is still too large
+    typedef CompactClock<uint16_t, 0, MillisClock> ShortClock;
+    TLeakyBucket<ShortClock> shortLeaky(1000, 10);
+    CHECK(!shortLeaky.tryAcquire(66, 0));
+    CHECK_EQUAL(TLeakyBucket<ShortClock>::NoDeadline, shortLeaky.timeUntilAvailable(66, 0));
+    CHECK(shortLeaky.tryAcquire(10, 0));
+    CHECK(!shortLeaky.tryAcquire(1, 0));
+
+    // A capacity whose level does not fit is reduced to 65 units
+    TLeakyBucket<ShortClock> bigLeaky(1000, 100);
+    CHECK(!bigLeaky.tryAcquire(66, 0));
+    CHECK(bigLeaky.tryAcquire(65, 0));
+    CHECK(!bigLeaky.tryAcquire(1, 0));
+
+    return testResult();
+}
@@ -0,0 +1,163 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  StaticSchedulerTest.cpp
+//!  @brief Checks StaticScheduler dispatch against the task periods and offsets
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <StaticScheduler.h>
+#include "HostTest.h"
+
+/*
+ *  Every task should run on the base tick where the time since begin() 
+ *  is a multiple of its period plus its offset, and after a stall of several 
+ *  hyperperiods each task runs once per period of the last hyperperiod 
+ *  and then carries on in phase.
+ */
+
+static unsigned long runs[3];
+static unsigned long outOfPhase[3];
+static unsigned long startTime;
+
+static const unsigned long Periods[3] = { 250, 100, 1000 };
+static const unsigned long Offsets[3] = { 0, 0, 50 };
+
+template <int TASK>
+void record()
+{
+    // Base tick n is dispatched once more than n * 50 ms have passed
+    unsigned long tickTime = (millis() - startTime) / 50 * 50;
+    runs[TASK]++;
+    if (tickTime % Periods[TASK] != Offsets[TASK]) outOfPhase[TASK]++;
+}
+
+typedef StaticScheduler<
+    StaticTask<250, record<0>>,
+    StaticTask<100, record<1>>,
+    StaticTask<1000, record<2>, 50>
+> Scheduler;
+
+static void clear()
+{
+    for (int i = 0; i < 3; i++) {
+        runs[i] = 0;
+        outOfPhase[i] = 0;
+    }
+}
+
+int main()
+{
+    CHECK_EQUAL(50, Scheduler::Tick);
+    CHECK_EQUAL(1000, Scheduler::HyperPeriod);
+    CHECK_EQUAL(2, Scheduler::MaxDuePerTick);
+
+    ArduinoHost::setMillis(12345);
+    startTime = millis();
+    clear();
+    Scheduler scheduler;
+    scheduler.begin();
+
+    // Polled every millisecond for two hyperperiods
+    for (unsigned long ms = 1; ms <= 2000; ms++) {
+        ArduinoHost::setMillis(startTime + ms);
+        scheduler.run();
+    }
+    CHECK_EQUAL(8, runs[0]);
+    CHECK_EQUAL(20, runs[1]);
+    CHECK_EQUAL(2, runs[2]);
+    CHECK_EQUAL(0, outOfPhase[0] + outOfPhase[1] + outOfPhase[2]);
+
+    // A stall of more than three hyperperiods dispatches the last one
+    clear();
+    ArduinoHost::setMillis(startTime + 5130);
+    CHECK_EQUAL(20, scheduler.run());
+    CHECK_EQUAL(4, runs[0]);
+    CHECK_EQUAL(10, runs[1]);
+    CHECK_EQUAL(1, runs[2]);
+
+    // and the tasks carry on in phase afterwards
+    clear();
+    for (unsigned long ms = 5131; ms <= 7000; ms++) {
+        ArduinoHost::setMillis(startTime + ms);
+        scheduler.run();
+    }
+    CHECK_EQUAL(7, runs[0]);
+    CHECK_EQUAL(18, runs[1]);
+    CHECK_EQUAL(1, runs[2]);
+    CHECK_EQUAL(0, outOfPhase[0] + outOfPhase[1] + outOfPhase[2]);
+
+    // A limit on tasks due together is checked at compile time
+    TStaticScheduler<2, StaticTask<250, record<0>>, StaticTask<100, record<1>>> limited;
+    (void)limited;
+
+    // The count does not depend on the hyperperiod, here about 11.7 days 
+    // of 1 ms ticks
+    typedef StaticScheduler<StaticTask<997, record<0>>, 
+                            StaticTask<1000, record<1>>, 
+                            StaticTask<1013, record<2>>> Coprime;
+    CHECK_EQUAL(1, Coprime::Tick);
+    CHECK_EQUAL(1009961000UL, Coprime::HyperPeriod);
+    CHECK_EQUAL(3, Coprime::MaxDuePerTick);
+
+    // Offsets that never line up keep one task per tick, while tasks 
+    // whose offsets agree modulo the GCD of their periods do meet
+    CHECK_EQUAL(1, (StaticScheduler<StaticTask<100, record<0>, 10>, 
+                                    StaticTask<100, record<1>, 20>, 
+                                    StaticTask<50, record<2>, 30>>::MaxDuePerTick));
+    CHECK_EQUAL(2, (StaticScheduler<StaticTask<60, record<0>, 10>, 
+                                    StaticTask<40, record<1>, 30>, 
+                                    StaticTask<25, record<2>, 4>>::MaxDuePerTick));
+
+    return testResult();
+}
@@ -0,0 +1,133 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TicklessIdleTest.cpp
+//!  @brief Counts TicklessIdle wakes on the virtual clock
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <BasicBlinker.h>
+#include <CallbackTimer.h>
+#include <TicklessIdle.h>
+#include "HostTest.h"
+
+/*
+ *  Runs a blinker and a continuous CallbackTimer under TicklessIdle with 
+ *  the ArduinoHost::idleSleep hook, and checks that every wake lands on a 
+ *  deadline: one sleep per event, no event late.
+ */
+
+static unsigned long reports = 0;
+static unsigned long lateReports = 0;
+static unsigned long expectedReportTime = 2001;
+
+static void onReport()
+{
+    if (millis() != expectedReportTime) lateReports++;
+    expectedReportTime += 2001;
+    reports++;
+}
+
+int main()
+{
+    ArduinoHost::setMillis(0);
+    BasicBlinker blinker(500);
+    CallbackTimer reportTimer(2000, onReport, TIMER_RUN_MODE_CONTINUOUS);
+    TicklessIdle<> idle(ArduinoHost::idleSleep);
+    idle.setSleepLimits(1, 100000);
+    blinker.reset();
+    reportTimer.start();
+    idle.add(blinker);
+    idle.add(reportTimer);
+
+    unsigned long toggles = 0;
+    unsigned long lateToggles = 0;
+    bool lastState = blinker.getState();
+    unsigned long expectedToggleTime = 501;
+    unsigned long wastedWakes = 0;
+    while (millis() < 10000) {
+        unsigned long before = toggles + reports;
+        idle.idle();
+        if (blinker.getState() != lastState) {
+            lastState = blinker.getState();
+            if (millis() != expectedToggleTime) lateToggles++;
+            expectedToggleTime += 501;
+            toggles++;
+        }
+        if (toggles + reports == before) wastedWakes++;
+    }
+
+    // Continuous timers restart when the expiry is seen, so the blinker 
+    // toggles every 501 ms and the report runs every 2001 ms.  The last 
+    // wake is the report at 10005 ms.
+    CHECK_EQUAL(19, toggles);
+    CHECK_EQUAL(5, reports);
+    CHECK_EQUAL(10005, millis());
+    CHECK_EQUAL(0, lateToggles);
+    CHECK_EQUAL(0, lateReports);
+    CHECK_EQUAL(0, wastedWakes);
+    CHECK_EQUAL(toggles + reports, idle.sleepCount());
+
+    // The sleep cap splits long waits into several wakes
+    ArduinoHost::setMillis(0);
+    CallbackTimer slowTimer(3000, nullptr, TIMER_RUN_MODE_ONE_SHOT);
+    TicklessIdle<> cappedIdle(ArduinoHost::idleSleep);
+    cappedIdle.setSleepLimits(1, 1000);
+    slowTimer.start();
+    cappedIdle.add(slowTimer);
+    while (!slowTimer.hasPreviouslyExpired()) cappedIdle.idle();
+    CHECK_EQUAL(4, cappedIdle.sleepCount());
+    CHECK_EQUAL(3001, millis());
+
+    return testResult();
+}
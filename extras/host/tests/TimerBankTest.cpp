@@ -0,0 +1,108 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerBankTest.cpp
+//!  @brief Checks TimerBank slots against shared timestamps
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <TimerBank.h>
+#include "HostTest.h"
+
+int main()
+{
+    ArduinoHost::setMillis(1000);
+    TimerBank<40> bank;
+
+    // Slot 0 lands in the 32 slot block, slot 33 in the tail
+    bank.begin(0, 100, TIMER_RUN_MODE_PERIODIC, 1000);
+    bank.begin(33, 100, TIMER_RUN_MODE_PERIODIC, 1000);
+    CHECK_EQUAL(101, bank.timeRemaining(0, 1000));
+    bank.run(1100);
+    CHECK(!bank.isDue(0));
+    CHECK(!bank.isDue(33));
+    bank.run(1101);
+    CHECK(bank.isDue(0));
+    CHECK(bank.isDue(33));
+    CHECK_EQUAL(100, bank.timeRemaining(0, 1101));
+
+    // Slots restarted after the timestamp a scan uses, as happens when 
+    // the handling of another slot calls start(), count as just started
+    TimerBank<40>::TickType snapshot = 1150;
+    bank.begin(1, 50, TIMER_RUN_MODE_ONE_SHOT, 1160);
+    bank.begin(34, 50, TIMER_RUN_MODE_PERIODIC, 1160);
+    bank.run(snapshot);
+    CHECK(!bank.isDue(1));
+    CHECK(!bank.isDue(34));
+    CHECK_EQUAL(51, bank.timeRemaining(1, snapshot));
+    CHECK_EQUAL(51, bank.timeRemaining(34, snapshot));
+    CHECK(!bank.hasPreviouslyExpired(1));
+
+    // They then expire on their own timeout, and the periodic slot keeps 
+    // its phase
+    bank.run(1210);
+    CHECK(!bank.isDue(1));
+    CHECK(!bank.isDue(34));
+    bank.run(1211);
+    CHECK(bank.isDue(1));
+    CHECK(bank.isDue(34));
+    CHECK(bank.hasPreviouslyExpired(1));
+    CHECK_EQUAL(50, bank.timeRemaining(34, 1211));
+
+    // A slot idle for longer than half the range still expires
+    bank.begin(2, 10, TIMER_RUN_MODE_ONE_SHOT, 1300);
+    bank.run(1300 + 0x7FFFFFFFUL);
+    CHECK(bank.isDue(2));
+
+    return testResult();
+}
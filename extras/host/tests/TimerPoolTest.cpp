@@ -0,0 +1,115 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerPoolTest.cpp
+//!  @brief Checks TimerPool timers started from callbacks
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <TimerPool.h>
+#include "HostTest.h"
+
+static TimerPool<4> pool;
+static unsigned long firstAt = 0;
+static unsigned long secondAt = 0;
+static unsigned long periodicCount = 0;
+
+static void second() { secondAt = millis(); }
+
+static void periodic() { periodicCount++; }
+
+static void first()
+{
+    firstAt = millis();
+    // A slow callback: the clock has moved on past the timestamp the pass
+    // is using when the new timers are started
+    ArduinoHost::advanceMillis(5);
+    pool.after(10, second);
+    pool.every(20, periodic);
+}
+
+int main()
+{
+    ArduinoHost::setMillis(1000);
+    pool.after(50, first);
+
+    // One pass against a timestamp taken before the callbacks ran
+    for (unsigned long ms = 1001; ms <= 1051; ms++) {
+        ArduinoHost::setMillis(ms);
+        pool.run(millis());
+    }
+    CHECK_EQUAL(1051, firstAt);
+    CHECK_EQUAL(0, secondAt);
+    CHECK_EQUAL(0, periodicCount);
+    CHECK_EQUAL(2, pool.active());
+    CHECK_EQUAL(11, pool.timeRemaining(1051));
+
+    // The new timers run from when they were started, at 1056
+    for (unsigned long ms = 1057; ms <= 1110; ms++) {
+        ArduinoHost::setMillis(ms);
+        pool.run(millis());
+        if (ms == 1066) CHECK_EQUAL(0, secondAt);
+    }
+    CHECK_EQUAL(1067, secondAt);
+    CHECK_EQUAL(2, periodicCount);
+    CHECK_EQUAL(1, pool.active());
+
+    // Handles go stale once their timer has fired or been cancelled
+    TimerPool<4>::Handle handle = pool.after(5, second);
+    CHECK(pool.isActive(handle));
+    CHECK(pool.cancel(handle));
+    CHECK(!pool.isActive(handle));
+    CHECK(!pool.cancel(handle));
+
+    return testResult();
+}
@@ -0,0 +1,314 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerServiceTest.cpp
+//!  @brief Checks TimerService ordering, arm/cancel races and shutdown
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <TimerService.h>
+#include <SteadyClock.h>
+#include "HostTest.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/*
+ *  The ordering checks drive run() by hand against a clock the test moves.
+ *  The race and shutdown checks use real threads and the steady clock, so
+ *  they only assert what must hold whatever the scheduling: no callback 
+ *  from a cancelled timer, exactly one from each one shot timer, and every
+ *  callback handed to a worker finished once end() returns.
+ * 
+ *  Build with: g++ -std=gnu++11 -pthread ...
+ */
+
+/**
+ * @brief A millisecond clock that only moves when the test moves it
+ */
+struct ManualClock
+{
+    typedef uint32_t TickType;
+
+    static std::atomic<uint32_t>& time()
+    {
+        static std::atomic<uint32_t> current(0);
+        return current;
+    }
+
+    static TickType now() { return time().load(); }
+
+    static constexpr unsigned long TicksPerSecond = 1000UL;
+};
+
+static const unsigned MaxFires = 16;
+
+struct FireLog
+{
+    unsigned slots[MaxFires];
+    uint32_t times[MaxFires];
+    unsigned count = 0;
+};
+
+static FireLog fireLog;
+
+static void recordFire(void* context)
+{
+    unsigned slot = static_cast<unsigned>(reinterpret_cast<uintptr_t>(context));
+    if (fireLog.count < MaxFires) {
+        fireLog.slots[fireLog.count] = slot;
+        fireLog.times[fireLog.count] = ManualClock::now();
+    }
+    fireLog.count++;
+}
+
+static TimerDelegate recorder(unsigned slot)
+{
+    return TimerDelegate(recordFire, reinterpret_cast<void*>(static_cast<uintptr_t>(slot)));
+}
+
+static void runUntil(TimerService<8, 16, ManualClock>& service, uint32_t end)
+{
+    while (ManualClock::now() < end) {
+        ManualClock::time()++;
+        service.run();
+    }
+}
+
+static void testOrdering()
+{
+    ManualClock::time() = 0;
+    fireLog = FireLog();
+    TimerService<8, 16, ManualClock> service;
+
+    // Fired in deadline order, whatever the slot order
+    service.arm(0, 30, recorder(0));
+    service.arm(1, 10, recorder(1));
+    service.arm(2, 20, recorder(2));
+
+    // Commands from one thread apply in the order they were sent
+    service.arm(3, 5, recorder(3));
+    service.cancel(3);
+    service.cancel(4);
+    service.arm(4, 25, recorder(4));
+
+    // Re-arming replaces the earlier timeout
+    service.arm(5, 5, recorder(5));
+    service.arm(5, 15, recorder(5));
+
+    runUntil(service, 40);
+    CHECK_EQUAL(5, fireLog.count);
+    CHECK_EQUAL(1, fireLog.slots[0]);
+    CHECK_EQUAL(11, fireLog.times[0]);
+    CHECK_EQUAL(5, fireLog.slots[1]);
+    CHECK_EQUAL(16, fireLog.times[1]);
+    CHECK_EQUAL(2, fireLog.slots[2]);
+    CHECK_EQUAL(21, fireLog.times[2]);
+    CHECK_EQUAL(4, fireLog.slots[3]);
+    CHECK_EQUAL(26, fireLog.times[3]);
+    CHECK_EQUAL(0, fireLog.slots[4]);
+    CHECK_EQUAL(31, fireLog.times[4]);
+    CHECK_EQUAL(TimerService<8>::NoDeadline, service.timeUntilNext());
+
+    // A periodic slot keeps firing until it is cancelled
+    fireLog = FireLog();
+    service.arm(6, 10, recorder(6), TIMER_RUN_MODE_PERIODIC);
+    runUntil(service, 71);
+    service.cancel(6);
+    runUntil(service, 100);
+    CHECK_EQUAL(3, fireLog.count);
+    CHECK_EQUAL(51, fireLog.times[0]);
+    CHECK_EQUAL(61, fireLog.times[1]);
+    CHECK_EQUAL(71, fireLog.times[2]);
+}
+
+typedef TimerService<64, 256, SteadyClock> Service;
+
+static const unsigned long Millisecond = 1000000UL;
+
+static std::atomic<unsigned long> raceFires(0);
+static std::atomic<unsigned long> slotFires[64];
+
+static void countRaceFire() { raceFires++; }
+
+static void countSlotFire(void* context)
+{
+    slotFires[reinterpret_cast<uintptr_t>(context)]++;
+}
+
+static void retry(bool (*send)(Service&, uint16_t, unsigned int), Service& service, uint16_t slot, unsigned int seed)
+{
+    while (!send(service, slot, seed)) {
+        std::this_thread::yield();
+    }
+}
+
+static bool armLong(Service& service, uint16_t slot, unsigned int seed)
+{
+    // 10 seconds or more, so none of these are due before they are cancelled
+    Service::TickType timeout = 10000 * Millisecond + seed % Millisecond;
+    return service.arm(slot, timeout, countRaceFire, static_cast<TimerRunMode>(seed & 0x3));
+}
+
+static bool cancel(Service& service, uint16_t slot, unsigned int) { return service.cancel(slot); }
+
+static void produce(Service& service, unsigned int seed)
+{
+    for (unsigned long i = 0; i < 20000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint16_t slot = (seed >> 8) % 64;
+        retry((seed & 0x10) ? armLong : cancel, service, slot, seed);
+    }
+}
+
+static bool waitFor(unsigned long expected, std::atomic<unsigned long>* counters, unsigned count)
+{
+    for (int attempt = 0; attempt < 2000; attempt++) {
+        unsigned long total = 0;
+        for (unsigned i = 0; i < count; i++) total += counters[i];
+        if (total >= expected) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+static void testRaces()
+{
+    Service service(4);
+    service.begin();
+
+    // Several threads arm and cancel the same slots at once
+    std::vector<std::thread> producers;
+    for (unsigned int p = 0; p < 4; p++) {
+        producers.push_back(std::thread(produce, std::ref(service), p + 1));
+    }
+    for (size_t p = 0; p < producers.size(); p++) {
+        producers[p].join();
+    }
+    for (uint16_t slot = 0; slot < 64; slot++) {
+        retry(cancel, service, slot, 0);
+    }
+
+    // Then every slot is armed once more as a short one shot
+    for (uint16_t slot = 0; slot < 64; slot++) {
+        slotFires[slot] = 0;
+        while (!service.arm(slot, Millisecond, TimerDelegate(countSlotFire, reinterpret_cast<void*>(static_cast<uintptr_t>(slot))))) {
+            std::this_thread::yield();
+        }
+    }
+    CHECK(waitFor(64, slotFires, 64));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    service.end();
+
+    CHECK_EQUAL(0, raceFires.load());
+    unsigned long wrong = 0;
+    for (uint16_t slot = 0; slot < 64; slot++) {
+        if (slotFires[slot] != 1) wrong++;
+    }
+    CHECK_EQUAL(0, wrong);
+}
+
+static std::atomic<unsigned long> started(0);
+static std::atomic<unsigned long> finished(0);
+
+static void slowCallback()
+{
+    started++;
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    finished++;
+}
+
+static void testShutdown()
+{
+    // end() joins every thread with periodic timers still armed and 
+    // callbacks still queued for the workers
+    Service service(4);
+    service.begin();
+    for (uint16_t slot = 0; slot < 8; slot++) {
+        service.arm(slot, Millisecond, slowCallback, TIMER_RUN_MODE_PERIODIC);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    service.end();
+    unsigned long afterEnd = started;
+    CHECK(afterEnd > 0);
+    CHECK_EQUAL(afterEnd, finished.load());
+
+    // Nothing runs once end() has returned
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK_EQUAL(afterEnd, started.load());
+
+    // begin() after end() starts the threads again
+    service.begin();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    service.end();
+    CHECK(started > afterEnd);
+    CHECK_EQUAL(started.load(), finished.load());
+
+    // The destructor stops a service that is still running
+    {
+        Service scoped(2);
+        scoped.begin();
+        scoped.arm(0, Millisecond, slowCallback, TIMER_RUN_MODE_CONTINUOUS);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    CHECK_EQUAL(started.load(), finished.load());
+}
+
+int main()
+{
+    testOrdering();
+    testRaces();
+    testShutdown();
+    return testResult();
+}
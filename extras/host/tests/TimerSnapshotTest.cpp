@@ -0,0 +1,147 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerSnapshotTest.cpp
+//!  @brief Checks TimerSnapshot save and restore through RamTimerStorage
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <TimerSnapshot.h>
+#include "HostTest.h"
+
+static void nothing() {}
+
+/**
+ * @brief RamTimerStorage that fails one chosen read
+ */
+class FlakyStorage: public RamTimerStorage<64>
+{
+    public:
+        unsigned long reads = 0;
+        unsigned long failOn = 0;
+
+        bool read(uint16_t address, uint8_t* data, uint16_t length)
+        {
+            if (++reads == failOn) return false;
+            return RamTimerStorage<64>::read(address, data, length);
+        }
+};
+
+int main()
+{
+    ArduinoHost::setMillis(5000);
+    BasicTimer maintenance(10000);
+    CallbackTimer retry(2000, nothing, TIMER_RUN_MODE_CONTINUOUS);
+    BasicBlinker blinker(300);
+    maintenance.reset();
+    retry.start();
+    blinker.reset();
+
+    TimerSnapshot<4> snapshot;
+    snapshot.add(maintenance);
+    snapshot.add(retry);
+    snapshot.add(blinker);
+
+    // Saved 1500 ms in, with the blinker toggled on
+    ArduinoHost::setMillis(6500);
+    blinker.update();
+    bool blinkerState = blinker.getState();
+    FlakyStorage storage;
+    CHECK(snapshot.save(storage));
+    CHECK(snapshot.verify(storage));
+
+    // After a reset the clock starts again from 0; 200 ms passed while off
+    ArduinoHost::setMillis(0);
+    BasicTimer restoredMaintenance(1);
+    CallbackTimer restoredRetry(1, nothing);
+    BasicBlinker restoredBlinker(1);
+    TimerSnapshot<4> restored;
+    restored.add(restoredMaintenance);
+    restored.add(restoredRetry);
+    restored.add(restoredBlinker);
+
+    // A read failing anywhere leaves every object as it was
+    unsigned long readsPerRestore = 0;
+    for (unsigned long failOn = 1; failOn <= 8; failOn++) {
+        storage.reads = 0;
+        storage.failOn = failOn;
+        bool applied = restored.restore(storage, 0, 200);
+        if (applied) break;
+        readsPerRestore = storage.reads;
+        CHECK_EQUAL(1, restoredMaintenance.timeout());
+        CHECK_EQUAL(1, restoredRetry.timeout());
+        CHECK(!restoredRetry.hasStarted());
+    }
+    CHECK_EQUAL(5, readsPerRestore);
+
+    // A clean restore carries on 1700 ms in
+    storage.failOn = 0;
+    CHECK(restored.restore(storage, 0, 200));
+    CHECK_EQUAL(10000, restoredMaintenance.timeout());
+    CHECK_EQUAL(10000 - 1700 + 1, restoredMaintenance.timeRemaining());
+    CHECK_EQUAL(2000, restoredRetry.timeout());
+    CHECK_EQUAL(2000 - 1700 + 1, restoredRetry.timeRemaining());
+    CHECK(restoredRetry.hasStarted());
+    CHECK_EQUAL(300, restoredBlinker.blinkTime());
+    CHECK_EQUAL(blinkerState, restoredBlinker.getState());
+
+    // A different registration list does not match
+    TimerSnapshot<4> other;
+    other.add(restoredRetry);
+    other.add(restoredMaintenance);
+    other.add(restoredBlinker);
+    CHECK(!other.verify(storage));
+    CHECK(!other.restore(storage));
+
+    return testResult();
+}
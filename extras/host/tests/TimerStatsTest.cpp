@@ -0,0 +1,119 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerStatsTest.cpp
+//!  @brief Checks TimerStats lateness and jitter figures
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <CallbackTimer.h>
+#include <TimerStats.h>
+#include "HostTest.h"
+
+// The layout a CallbackTimer had before statistics were a policy
+struct PlainLayout: BasicTimer
+{
+    uint8_t flags;
+    void (*callback)();
+};
+
+int main()
+{
+    TimerStats stats;
+    CHECK_EQUAL(0, stats.meanJitter());
+    CHECK_EQUAL(0, stats.maxJitter());
+
+    // Steady lateness has no jitter
+    stats.record(5);
+    stats.record(5);
+    stats.record(5);
+    CHECK_EQUAL(5, stats.meanLateness());
+    CHECK_EQUAL(0, stats.meanJitter());
+    CHECK_EQUAL(0, stats.maxJitter());
+
+    // Changes in either direction count
+    stats.record(0);
+    stats.record(8);
+    stats.record(7);
+    CHECK_EQUAL(6, stats.fireCount());
+    CHECK_EQUAL(0, stats.minLateness());
+    CHECK_EQUAL(8, stats.maxLateness());
+    CHECK_EQUAL(8, stats.maxJitter());
+    CHECK_EQUAL((0 + 0 + 5 + 8 + 1) / 5, stats.meanJitter());
+    CHECK_EQUAL(1, stats.bucket(0));
+    CHECK_EQUAL(4, stats.bucket(3));
+    CHECK_EQUAL(1, stats.bucket(4));
+
+    // The first expiry after clear() has nothing to compare with
+    stats.clear();
+    stats.record(20);
+    CHECK_EQUAL(0, stats.maxJitter());
+    stats.record(12);
+    CHECK_EQUAL(8, stats.maxJitter());
+    CHECK_EQUAL(8, stats.meanJitter());
+
+    // A StatsCallbackTimer records each expiry as run() sees it
+    ArduinoHost::setMillis(0);
+    StatsCallbackTimer timer(100, nullptr, TIMER_RUN_MODE_PERIODIC);
+    timer.start();
+    timer.run(101);
+    timer.run(205);
+    CHECK_EQUAL(2, timer.stats().fireCount());
+    CHECK_EQUAL(0, timer.stats().minLateness());
+    CHECK_EQUAL(4, timer.stats().maxLateness());
+
+    // Timers without statistics carry nothing for them
+    CHECK_EQUAL(sizeof(PlainLayout), sizeof(CallbackTimer));
+
+    return testResult();
+}
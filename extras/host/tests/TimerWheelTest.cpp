@@ -0,0 +1,169 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerWheelTest.cpp
+//!  @brief Checks TimerWheel periodic timers against CallbackTimer
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#include <Arduino.h>
+#include <TimerWheel.h>
+#include "HostTest.h"
+
+/*
+ *  Runs a periodic WheelTimer and a CallbackTimer with the same timeout 
+ *  and mode side by side, servicing both at the same moments, and checks
+ *  that they fire at the same times, including across a long stall in 
+ *  loop().
+ */
+
+static const unsigned MaxFires = 64;
+
+struct FireLog
+{
+    unsigned long times[MaxFires];
+    unsigned count = 0;
+
+    void add()
+    {
+        if (count < MaxFires) times[count] = millis();
+        count++;
+    }
+};
+
+static FireLog wheelLog;
+static FireLog callbackLog;
+static void onWheel() { wheelLog.add(); }
+static void onCallback() { callbackLog.add(); }
+
+static bool sameFires()
+{
+    if (wheelLog.count != callbackLog.count) return false;
+    for (unsigned i = 0; i < wheelLog.count && i < MaxFires; i++) {
+        if (wheelLog.times[i] != callbackLog.times[i]) return false;
+    }
+    return true;
+}
+
+/*
+ *  Services both timers every millisecond from 0 to duration, except 
+ *  during the stall, when loop() is stuck and nothing is serviced.
+ */
+static void compare(unsigned long timeout, TimerRunMode mode, unsigned long duration,
+                    unsigned long stallStart = 0, unsigned long stallEnd = 0)
+{
+    wheelLog = FireLog();
+    callbackLog = FireLog();
+    ArduinoHost::setMillis(0);
+
+    TimerWheel<> wheel;
+    WheelTimer wheelTimer(timeout, onWheel, mode);
+    CallbackTimer callbackTimer(timeout, onCallback, mode);
+    wheel.begin();
+    wheel.start(wheelTimer);
+    callbackTimer.start();
+
+    for (unsigned long ms = 1; ms <= duration; ms++) {
+        ArduinoHost::setMillis(ms);
+        if (ms > stallStart && ms < stallEnd) continue;
+        wheel.service();
+        callbackTimer.run();
+    }
+}
+
+int main()
+{
+    // A 1 ms periodic timer fires every millisecond after the first
+    compare(1, TIMER_RUN_MODE_PERIODIC, 20);
+    CHECK_EQUAL(19, wheelLog.count);
+    CHECK(sameFires());
+
+    compare(100, TIMER_RUN_MODE_PERIODIC, 700);
+    CHECK_EQUAL(6, wheelLog.count);
+    CHECK(sameFires());
+
+    // Stalled from 102 to 400 ms: one late fire at 400, then back in phase
+    compare(100, TIMER_RUN_MODE_PERIODIC, 650, 101, 400);
+    CHECK_EQUAL(5, wheelLog.count);
+    CHECK_EQUAL(101, wheelLog.times[0]);
+    CHECK_EQUAL(400, wheelLog.times[1]);
+    CHECK_EQUAL(401, wheelLog.times[2]);
+    CHECK_EQUAL(501, wheelLog.times[3]);
+    CHECK_EQUAL(601, wheelLog.times[4]);
+    CHECK(sameFires());
+
+    // A stall ending between deadlines
+    compare(100, TIMER_RUN_MODE_PERIODIC, 650, 101, 350);
+    CHECK(sameFires());
+
+    // Catch up mode fires once for every missed period
+    compare(100, TIMER_RUN_MODE_PERIODIC_CATCH_UP, 650, 101, 400);
+    CHECK_EQUAL(6, wheelLog.count);
+    CHECK_EQUAL(callbackLog.count, wheelLog.count);
+
+    // A single level of 16 slots, 100 ms is several turns of the wheel
+    wheelLog = FireLog();
+    ArduinoHost::setMillis(0);
+    TimerWheel<4, 1> shortWheel;
+    WheelTimer longTimer(100, onWheel, TIMER_RUN_MODE_PERIODIC);
+    shortWheel.begin();
+    shortWheel.start(longTimer);
+    for (unsigned long ms = 1; ms <= 250; ms++) {
+        ArduinoHost::setMillis(ms);
+        shortWheel.service();
+    }
+    CHECK_EQUAL(2, wheelLog.count);
+    CHECK_EQUAL(101, wheelLog.times[0]);
+    CHECK_EQUAL(201, wheelLog.times[1]);
+
+    return testResult();
+}
@@ -59,7 +59,7 @@
 #ifndef _BASIC_TIMER_BASIC_BLINKER_H_
 #define _BASIC_TIMER_BASIC_BLINKER_H_
 
-#include "./BasicTimer.h"
+#include "./TimerCore.h"
 
 /**
  * @brief Class that toggles a boolean value at a constant time interval.
@@ -72,14 +72,14 @@ class BasicBlinker
         /**
          * @brief Construct a new BasicBlinker with the default time (500 ms)
          */
-        BasicBlinker(): timer(500){};
+        BasicBlinker(): timer(500), runMode(TIMER_RUN_MODE_CONTINUOUS){};
 
         /**
          * @brief Construct a new BasicBlinker object with the supplied time
          * 
          * @param timeout The blink time in milliseconds
          */
-        BasicBlinker(uint32_t timeout): timer(timeout){};
+        BasicBlinker(uint32_t timeout): timer(timeout), runMode(TIMER_RUN_MODE_CONTINUOUS){};
 
         /**
          * @brief Set the blink time for the blinker, which is the amount of time
@@ -111,13 +111,52 @@ class BasicBlinker
          */
         void run()
         {
-            if (timer.hasExpired())
+            run(timer.now());
+        }
+
+        /**
+         * @brief Update the state of the blinker against a timestamp 
+         *        taken earlier with BasicTimer::now().
+         * 
+         * @param current The timestamp to update against
+         */
+        void run(BasicTimer::TickType current)
+        {
+            if (timer.hasExpired(current))
             {
-                timer.reset();
-                state = !state;
+                if (runMode == TIMER_RUN_MODE_PERIODIC || 
+                    runMode == TIMER_RUN_MODE_PERIODIC_CATCH_UP) 
+                {
+                    if (timer.advance(current) & 1) state = !state;
+                }
+                else 
+                {
+                    timer.reset(current);
+                    state = !state;
+                }
             }
         }
 
+        /**
+         * @brief Sets how the blinker keeps time.
+         * 
+         *        TIMER_RUN_MODE_CONTINUOUS (the default) restarts the blink 
+         *        time whenever the blinker toggles, so loop lateness adds up.
+         *        TIMER_RUN_MODE_PERIODIC and TIMER_RUN_MODE_PERIODIC_CATCH_UP
+         *        keep the original phase, and a blinker that missed whole
+         *        blink times lands on the state it would have had.
+         * 
+         * @param mode The TimerRunMode
+         */
+        void setMode(TimerRunMode mode){ runMode = mode & 0x3; };
+
+        /**
+         * @brief Gets the current blinker mode
+         * 
+         * @return TimerRunMode 
+         */
+        TimerRunMode mode() const { return static_cast<TimerRunMode>(runMode); };
+
         /**
          * @brief Updates the state of the blinker based on elapsed time, 
          *        returning the current blink state as a result.
@@ -130,6 +169,29 @@ class BasicBlinker
             return state;
         }
 
+        /**
+         * @brief The amount of time left until the blinker next 
+         *        toggles in milliseconds.
+         * 
+         * @return uint32_t The remaining time in milliseconds
+         */
+        uint32_t timeRemaining() const
+        {
+            return timer.timeRemaining();
+        }
+
+        /**
+         * @brief The amount of time left until the blinker next toggles,
+         *        measured from a timestamp taken earlier with BasicTimer::now().
+         * 
+         * @param current The timestamp to measure from
+         * @return uint32_t The remaining time in milliseconds
+         */
+        uint32_t timeRemaining(BasicTimer::TickType current) const
+        {
+            return timer.timeRemaining(current);
+        }
+
         /**
          * @brief Reset the blinker to its initial state (false)
          */
@@ -167,8 +229,11 @@ class BasicBlinker
             return *this;
         }
     protected:
+        template <uint8_t CAPACITY> friend class TimerSnapshot;
+
         BasicTimer timer;
-        bool state;
+        bool state : 1;
+        uint8_t runMode : 2; //!< The TimerRunMode, packed in with state
 };
 
 /**
@@ -176,16 +241,22 @@ class BasicBlinker
  * 
  *     Helpful for blinking LED's at a consistant time (or anything really)
  * 
- * @tparam TIMEOUT The blink time in milliseconds.
+ * @tparam TIMEOUT The blink time in milliseconds (in clock ticks for other clocks).
+ * @tparam Clock The clock policy, a CompactClock makes the blinker smaller.
  */
-template<unsigned int TIMEOUT>
+template<unsigned int TIMEOUT, typename Clock = MillisClock>
 class StaticBlinker
 {
     public:
+        /**
+         * @brief The clock's timestamp type
+         */
+        typedef typename TStaticTimer<TIMEOUT, Clock>::TickType TickType;
+
         /**
          * @brief Construct a new StaticBlinker
          */
-        StaticBlinker(): timer(){};
+        StaticBlinker(): timer(), runMode(TIMER_RUN_MODE_CONTINUOUS){};
 
         /**
          * @brief Update the state of the blinker based on elapsed tiem.
@@ -193,14 +264,52 @@ class StaticBlinker
          */
         void run()
         {
-            if (timer.hasExpired())
-            {
-                timer.reset();
+            run(timer.now());
+        }
 
-                state = !state;
+        /**
+         * @brief Update the state of the blinker against a timestamp 
+         *        taken earlier with Clock::now().
+         * 
+         * @param current The timestamp to update against
+         */
+        void run(TickType current)
+        {
+            if (timer.hasExpired(current))
+            {
+                if (runMode == TIMER_RUN_MODE_PERIODIC || 
+                    runMode == TIMER_RUN_MODE_PERIODIC_CATCH_UP) 
+                {
+                    if (timer.advance(current) & 1) state = !state;
+                }
+                else 
+                {
+                    timer.reset(current);
+                    state = !state;
+                }
             }
         }
 
+        /**
+         * @brief Sets how the blinker keeps time.
+         * 
+         *        TIMER_RUN_MODE_CONTINUOUS (the default) restarts the blink 
+         *        time whenever the blinker toggles, so loop lateness adds up.
+         *        TIMER_RUN_MODE_PERIODIC and TIMER_RUN_MODE_PERIODIC_CATCH_UP
+         *        keep the original phase, and a blinker that missed whole
+         *        blink times lands on the state it would have had.
+         * 
+         * @param mode The TimerRunMode
+         */
+        void setMode(TimerRunMode mode){ runMode = mode & 0x3; };
+
+        /**
+         * @brief Gets the current blinker mode
+         * 
+         * @return TimerRunMode 
+         */
+        TimerRunMode mode() const { return static_cast<TimerRunMode>(runMode); };
+
         /**
          * @brief Update the state of the blinker based on elapsed tiem.
          * 
@@ -212,6 +321,29 @@ class StaticBlinker
             return state;
         }
 
+        /**
+         * @brief The amount of time left until the blinker next 
+         *        toggles in milliseconds.
+         * 
+         * @return uint32_t The remaining time in milliseconds
+         */
+        uint32_t timeRemaining() const
+        {
+            return timer.timeRemaining();
+        }
+
+        /**
+         * @brief The amount of time left until the blinker next toggles,
+         *        measured from a timestamp taken earlier with Clock::now().
+         * 
+         * @param current The timestamp to measure from
+         * @return uint32_t The remaining time in milliseconds
+         */
+        uint32_t timeRemaining(TickType current) const
+        {
+            return timer.timeRemaining(current);
+        }
+
         /**
          * @brief Reset the blinker to its initial state (false)
          */
@@ -263,11 +395,16 @@ class StaticBlinker
         /**
          * @brief The blinkers underlying timer
          */
-        StaticTimer<TIMEOUT> timer;
+        TStaticTimer<TIMEOUT, Clock> timer;
         /**
          * @brief The stored blinker state
          */
-        bool state;
+        bool state : 1;
+        /**
+         * @brief How the blinker keeps time (a TimerRunMode), packed 
+         *        into the same byte as state
+         */
+        uint8_t runMode : 2;
 };
 
 /**
@@ -414,6 +551,7 @@ class StaticSwitchableBlinker: public StaticBlinker<TIMEOUT>
         StaticSwitchableBlinker& operator=(bool newState)
         {
             enabled = newState;
+            return *this;
         }
     protected:
         /**
@@ -0,0 +1,276 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  BlinkerBank.h
+//!  @brief BlinkerBank class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_BLINKER_BANK_H_
+#define _BASIC_TIMER_BLINKER_BANK_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief Up to 32 blinkers run from one clock read, with their states 
+ *        packed into a bitmask and written out together.
+ * 
+ *    Driving many LEDs from BasicBlinkers costs one clock read and one 
+ *    digitalWrite() per LED per loop.  A BlinkerBank keeps each blinker's 
+ *    blink time and last toggle in parallel arrays, updates them all 
+ *    against one clock read, and packs the results into one bit per 
+ *    blinker.  When any bit changes the mask is handed to a PortWriter, 
+ *    which can write a whole GPIO port or shift register chain at once.
+ * 
+ *    Blinkers toggle on whole multiples of their blink time from begin(),
+ *    like a BasicBlinker in TIMER_RUN_MODE_PERIODIC, so blinkers with 
+ *    related blink times stay in step.
+ * 
+ * @tparam N The number of blinkers, up to 32.  Bit i of the mask is blinker i.
+ */
+template <uint8_t N>
+class BlinkerBank
+{
+    static_assert(N > 0 && N <= 32, "BlinkerBank holds 1 to 32 blinkers");
+
+    public:
+        /**
+         * @brief Writes the blinker states out.
+         * 
+         * @param states The state of every blinker, bit i for blinker i
+         * @param changed The bits that changed since the last write
+         */
+        typedef void (*PortWriter)(uint32_t states, uint32_t changed);
+
+        /**
+         * @brief Construct a new BlinkerBank with every blinker stopped and off
+         * 
+         * @param writer The function that writes the states out, may be nullptr
+         */
+        BlinkerBank(PortWriter writer = nullptr): portWriter(writer), stateBits(0), writtenBits(0), enabledBits(0)
+        {
+            for (uint8_t i = 0; i < N; i++) {
+                lastToggle[i] = 0;
+                blinkTimes[i] = 0;
+            }
+        };
+
+        /**
+         * @brief Assign the function that writes the states out
+         * 
+         * @param writer The PortWriter, or nullptr for none
+         */
+        void onChange(PortWriter writer) { portWriter = writer; };
+
+        /**
+         * @brief Starts a blinker in the off state
+         * 
+         * @param index The blinker number, less than N
+         * @param blinkTime The time in milliseconds it stays on or off
+         */
+        void begin(uint8_t index, unsigned long blinkTime)
+        {
+            begin(index, blinkTime, BasicTimer::now());
+        }
+
+        /**
+         * @brief Starts a blinker in the off state from a timestamp taken 
+         *        earlier with BasicTimer::now().  Blinkers started with the 
+         *        same timestamp stay in phase.
+         * 
+         * @param index The blinker number, less than N
+         * @param blinkTime The time in milliseconds it stays on or off
+         * @param current The timestamp to start from
+         */
+        void begin(uint8_t index, unsigned long blinkTime, BasicTimer::TickType current)
+        {
+            blinkTimes[index] = blinkTime;
+            lastToggle[index] = current;
+            stateBits &= ~maskOf(index);
+            enabledBits |= maskOf(index);
+        }
+
+        /**
+         * @brief Stops a blinker and holds it in the given state
+         * 
+         * @param index The blinker number, less than N
+         * @param state The state to hold - defaults to off
+         */
+        void stop(uint8_t index, bool state = false)
+        {
+            enabledBits &= ~maskOf(index);
+            if (state) {
+                stateBits |= maskOf(index);
+            } else {
+                stateBits &= ~maskOf(index);
+            }
+        }
+
+        /**
+         * @brief Change a blinker's blink time.  Takes effect from its last toggle.
+         * 
+         * @param index The blinker number, less than N
+         * @param blinkTime The time in milliseconds it stays on or off
+         */
+        void setBlinkTime(uint8_t index, unsigned long blinkTime) { blinkTimes[index] = blinkTime; };
+
+        /**
+         * @brief Update every blinker and write the states out if any 
+         *        changed.  Should be called at least every loop.
+         * 
+         * @return uint32_t The state of every blinker
+         */
+        uint32_t run() { return run(BasicTimer::now()); };
+
+        /**
+         * @brief Update every blinker against a timestamp taken earlier with
+         *        BasicTimer::now(), and write the states out if any changed.
+         * 
+         *        A blinker started with begin() after the timestamp was 
+         *        taken (by another object's callback, for example) is left 
+         *        alone until a later timestamp.
+         * 
+         * @param current The timestamp to update against
+         * @return uint32_t The state of every blinker
+         * @see TimerGroup
+         */
+        uint32_t run(BasicTimer::TickType current)
+        {
+            uint32_t toggles = 0;
+            for (uint8_t i = 0; i < N; i++) {
+                BasicTimer::TickType elapsed = elapsedSince(i, current);
+                if (!(enabledBits & maskOf(i)) || elapsed <= blinkTimes[i]) continue;
+                BasicTimer::TickType periods = 1;
+                if (blinkTimes[i] > 0) {
+                    periods = (elapsed - 1) / blinkTimes[i];
+                    lastToggle[i] += periods * blinkTimes[i];
+                } else {
+                    lastToggle[i] = current;
+                }
+                if (periods & 1) toggles |= maskOf(i);
+            }
+            stateBits ^= toggles;
+            flush();
+            return stateBits;
+        }
+
+        /**
+         * @brief Writes the states out now if any changed since the last 
+         *        write, for example after stop().
+         */
+        void flush()
+        {
+            uint32_t changed = stateBits ^ writtenBits;
+            if (changed == 0) return;
+            writtenBits = stateBits;
+            if (portWriter != nullptr) portWriter(stateBits, changed);
+        }
+
+        /**
+         * @brief Get the state of every blinker (does not update them)
+         * 
+         * @return uint32_t Bit i is the state of blinker i
+         */
+        uint32_t states() const { return stateBits; };
+
+        /**
+         * @brief Get the state of one blinker (does not update it)
+         * 
+         * @param index The blinker number, less than N
+         */
+        bool getState(uint8_t index) const { return stateBits & maskOf(index); };
+
+        /**
+         * @brief The time until the next blinker toggles, measured from a 
+         *        timestamp taken earlier with BasicTimer::now().
+         * 
+         * @param current The timestamp to measure from
+         * @return unsigned long The time in milliseconds, 0 if one is due, 
+         *         or BasicTimer::NoDeadline if every blinker is stopped
+         */
+        unsigned long timeRemaining(BasicTimer::TickType current) const
+        {
+            unsigned long earliest = BasicTimer::NoDeadline;
+            for (uint8_t i = 0; i < N; i++) {
+                if (!(enabledBits & maskOf(i))) continue;
+                BasicTimer::TickType elapsed = elapsedSince(i, current);
+                unsigned long remaining = (elapsed > blinkTimes[i]) ? 0 : blinkTimes[i] - elapsed + 1;
+                if (remaining < earliest) earliest = remaining;
+            }
+            return earliest;
+        }
+
+    protected:
+        PortWriter portWriter;
+        BasicTimer::TickType lastToggle[N];
+        BasicTimer::TickType blinkTimes[N];
+        uint32_t stateBits;
+        uint32_t writtenBits;
+        uint32_t enabledBits;
+
+        static uint32_t maskOf(uint8_t index) { return static_cast<uint32_t>(1) << index; }
+
+        /**
+         * @brief The time since a blinker's last toggle, or 0 if it was 
+         *        started after the timestamp
+         */
+        BasicTimer::TickType elapsedSince(uint8_t index, BasicTimer::TickType current) const
+        {
+            BasicTimer::TickType elapsed = current - lastToggle[index];
+            if (static_cast<int32_t>(elapsed) < 0) return 0;
+            return elapsed;
+        }
+};
+
+#endif /* _BASIC_TIMER_BLINKER_BANK_H_ */
@@ -0,0 +1,232 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  BlinkerGroup.h
+//!  @brief BlinkerGroup class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_BLINKER_GROUP_H_
+#define _BASIC_TIMER_BLINKER_GROUP_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief Up to 32 blinkers locked to one master timer, each running at a 
+ *        multiple or fraction of a common blink time with its own phase.
+ * 
+ *    Separate BasicBlinkers started at different times never line up, and
+ *    each one checks its own timer.  A BlinkerGroup has one timer that 
+ *    ticks SUBDIVISIONS times per blink time, and every member's state is
+ *    worked out from the shared tick count:
+ * 
+ *        state = ((ticks + offset) / ticksPerToggle) & 1
+ * 
+ *    so members can never drift apart.  A loop() pass where no tick is due
+ *    costs a single timer comparison, however many members there are.
+ * 
+ *    By default members toggle once per blink time.  setDivider() makes a 
+ *    member blink d times slower, setMultiplier() m times faster (m must 
+ *    divide SUBDIVISIONS), and the offset shifts a member by a number of 
+ *    ticks, which turns a row of LEDs with stepped offsets into a chase.
+ * 
+ * @tparam N The number of members, up to 32.  Bit i of states() is member i.
+ * @tparam SUBDIVISIONS The number of master ticks per blink time
+ */
+template <uint8_t N, uint8_t SUBDIVISIONS = 1>
+class BlinkerGroup
+{
+    static_assert(N > 0 && N <= 32, "BlinkerGroup holds 1 to 32 members");
+    static_assert(SUBDIVISIONS > 0, "BlinkerGroup needs at least one tick per blink time");
+
+    public:
+        /**
+         * @brief Construct a new BlinkerGroup.  Every member starts at the 
+         *        blink time with no offset.
+         * 
+         * @param blinkTime The time in milliseconds a default member stays 
+         *        on or off.  The master tick is blinkTime / SUBDIVISIONS.
+         */
+        BlinkerGroup(unsigned long blinkTime = 500): timer(blinkTime / SUBDIVISIONS), ticks(0), stateBits(0)
+        {
+            for (uint8_t i = 0; i < N; i++) {
+                toggleTicks[i] = SUBDIVISIONS;
+                offsets[i] = 0;
+            }
+        };
+
+        /**
+         * @brief Makes a member blink divider times slower than the blink time
+         * 
+         * @param index The member number, less than N
+         * @param divider How many blink times the member stays on or off
+         * @param offset The phase offset in master ticks
+         */
+        void setDivider(uint8_t index, uint16_t divider, uint16_t offset = 0)
+        {
+            toggleTicks[index] = (divider > 0 ? divider : 1) * SUBDIVISIONS;
+            offsets[index] = offset;
+            update();
+        }
+
+        /**
+         * @brief Makes a member blink multiplier times faster than the blink
+         *        time.  The fastest a member can toggle is once per master tick.
+         * 
+         * @param index The member number, less than N
+         * @param multiplier How many times faster, which should divide SUBDIVISIONS
+         * @param offset The phase offset in master ticks
+         */
+        void setMultiplier(uint8_t index, uint8_t multiplier, uint16_t offset = 0)
+        {
+            uint16_t perToggle = SUBDIVISIONS / (multiplier > 0 ? multiplier : 1);
+            toggleTicks[index] = perToggle > 0 ? perToggle : 1;
+            offsets[index] = offset;
+            update();
+        }
+
+        /**
+         * @brief Restarts the master phase.  Every member goes to the state
+         *        its offset gives at tick 0.
+         */
+        void begin() { begin(timer.now()); };
+
+        /**
+         * @brief Restarts the master phase from a timestamp taken earlier 
+         *        with BasicTimer::now().
+         * 
+         * @param current The timestamp to start from
+         */
+        void begin(BasicTimer::TickType current)
+        {
+            ticks = 0;
+            timer.reset(current);
+            update();
+        }
+
+        /**
+         * @brief Update the members based on elapsed time.
+         *        Should be called at least every loop.
+         * 
+         * @return bool True if any member changed state
+         */
+        bool run() { return run(timer.now()); };
+
+        /**
+         * @brief Update the members against a timestamp taken earlier with 
+         *        BasicTimer::now().
+         * 
+         * @param current The timestamp to update against
+         * @return bool True if any member changed state
+         */
+        bool run(BasicTimer::TickType current)
+        {
+            if (!timer.hasExpired(current)) return false;
+            ticks += timer.advance(current);
+            uint32_t previous = stateBits;
+            update();
+            return stateBits != previous;
+        }
+
+        /**
+         * @brief Get the state of every member (does not update them)
+         * 
+         * @return uint32_t Bit i is the state of member i
+         */
+        uint32_t states() const { return stateBits; };
+
+        /**
+         * @brief Get the state of one member (does not update it)
+         * 
+         * @param index The member number, less than N
+         */
+        bool getState(uint8_t index) const { return (stateBits >> index) & 1; };
+
+        /**
+         * @brief The number of master ticks since begin()
+         * 
+         * @return unsigned long 
+         */
+        unsigned long tickCount() const { return ticks; };
+
+        /**
+         * @brief The time until the next master tick, measured from a 
+         *        timestamp taken earlier with BasicTimer::now().
+         * 
+         * @param current The timestamp to measure from
+         * @return unsigned long The time in milliseconds
+         */
+        unsigned long timeRemaining(BasicTimer::TickType current) const { return timer.timeRemaining(current); };
+
+    protected:
+        BasicTimer timer;
+        unsigned long ticks;
+        uint32_t stateBits;
+        uint16_t toggleTicks[N];
+        uint16_t offsets[N];
+
+        /**
+         * @brief Works out every member's state from the tick count
+         */
+        void update()
+        {
+            uint32_t states = 0;
+            for (uint8_t i = 0; i < N; i++) {
+                if (((ticks + offsets[i]) / toggleTicks[i]) & 1) states |= static_cast<uint32_t>(1) << i;
+            }
+            stateBits = states;
+        }
+};
+
+#endif /* _BASIC_TIMER_BLINKER_GROUP_H_ */
@@ -59,24 +59,76 @@
 #ifndef _BASIC_TIMER_CALLBACK_TIMER_H
 #define _BASIC_TIMER_CALLBACK_TIMER_H
 
-#include "./BasicTimer.h"
+#include "./TimerCore.h"
+#include "./TimerDelegate.h"
+#include "./TimerStats.h"
 
-enum TimerRunMode: uint8_t {
-    TIMER_RUN_MODE_ONE_SHOT = 0,
-    TIMER_RUN_MODE_CONTINUOUS = 1
+/**
+ * @brief Statistics storage for a TCallbackTimer.  Holds a Stats object,
+ *        fed the lateness of every expiry, and returned by stats().
+ * 
+ * @tparam Stats A class with record(uint32_t lateness), such as TimerStats
+ */
+template <typename Stats>
+class CallbackTimerStats
+{
+    public:
+        /**
+         * @brief The lateness statistics gathered by run()
+         * 
+         * @return Stats& The statistics, which may be cleared or printed
+         */
+        Stats& stats() { return timerStats; }
+
+        /**
+         * @brief The lateness statistics gathered by run()
+         */
+        const Stats& stats() const { return timerStats; }
+
+    protected:
+        /**
+         * @brief Lateness statistics storage
+         */
+        Stats timerStats;
+
+        void recordLateness(uint32_t lateness) { timerStats.record(lateness); }
+};
+
+/**
+ * @brief No statistics.  Empty, so it adds nothing to the size of a timer,
+ *        and recordLateness() compiles to nothing.
+ */
+template <>
+class CallbackTimerStats<void>
+{
+    protected:
+        void recordLateness(uint32_t) {}
 };
 
 /**
  * @brief Class for A Basic Timer That Provides a callback on expire
  * 
+ *    The callback type is a template parameter.  CallbackTimer uses a 
+ *    plain function pointer; DelegateTimer uses a TimerDelegate so that 
+ *    the callback can be a member function or a small lambda.
+ * 
+ *    The statistics policy is a template parameter too, so timers with and
+ *    without statistics are distinct types and can be mixed in one sketch.
+ *    StatsCallbackTimer and StatsDelegateTimer keep a TimerStats available
+ *    through stats(); CallbackTimer and DelegateTimer keep none.
+ * 
+ * @tparam Callback Any type that can be called with no arguments, 
+ *         constructed from nullptr and tested with if (callback)
+ * @tparam Stats The statistics class fed by run(), or void for none
  */
-class CallbackTimer: public BasicTimer
+template <typename Callback = void(*)(), typename Stats = void>
+class TCallbackTimer: public BasicTimer, public CallbackTimerStats<Stats>
 {
     public:
         /**
          * @brief onExpire callback handler type
          */
-        typedef void(*OnExpireFunction)();
+        typedef Callback OnExpireFunction;
 
         /**
          * @brief Construct a new BasicCallbackTimer object with the provided timeout and callback
@@ -84,12 +136,12 @@ class CallbackTimer: public BasicTimer
          * @param timeout The timeout in milliseconds
          * @param callback The onExpire callback function
          */
-        CallbackTimer(unsigned long timeout = 500, 
+        TCallbackTimer(unsigned long timeout = 500, 
                            OnExpireFunction callback = nullptr, 
                            TimerRunMode mode = TIMER_RUN_MODE_ONE_SHOT): 
                                 BasicTimer(timeout), 
-                                expiredCallback(callback),
-                                stateFlags(static_cast<uint8_t>(mode) & TimerModeMask)
+                                stateFlags(static_cast<uint8_t>(mode) & TimerModeMask),
+                                expiredCallback(callback)
                                 {};
 
         /**
@@ -141,7 +193,7 @@ class CallbackTimer: public BasicTimer
          * 
          * @param callback The onExpire callback function
          */
-        void onExpire(OnExpireFunction callback){ expiredCallback = callback; }
+        void onExpire(const OnExpireFunction& callback){ expiredCallback = callback; }
 
         /**
          * @brief Run the timer.
@@ -149,21 +201,55 @@ class CallbackTimer: public BasicTimer
          *      This function should be called from the main loop 
          *      and it will automatically call the callback function
          *      when the timer expires.
+         * 
+         * @return unsigned long The number of timeout periods that 
+         *         ended since the last run (0 if the timer has not expired)
          */
-        void run()
+        unsigned long run()
         {
-            if (hasExpired())
-            {
-                if (!hasPreviouslyExpired()) {
-                    bitSet(stateFlags, ExpireFlagBit);
-                    if (mode() == TIMER_RUN_MODE_CONTINUOUS) {
-                        this->reset();
-                    }
-                    if (expiredCallback != nullptr) {
+            return run(now());
+        }
+
+        /**
+         * @brief Run the timer against a timestamp taken earlier with now().
+         * 
+         *      Used to run many timers against a single clock read.
+         * 
+         * @param current The timestamp to run against
+         * @return unsigned long The number of timeout periods that 
+         *         ended since the last run (0 if the timer has not expired)
+         * @see TimerGroup
+         */
+        unsigned long run(TickType current)
+        {
+            if (!hasExpired(current)) return 0;
+
+            TimerRunMode runMode = mode();
+            TickType lateness = elapsedTime(current) - timeout() - 1;
+            if (runMode == TIMER_RUN_MODE_PERIODIC || 
+                runMode == TIMER_RUN_MODE_PERIODIC_CATCH_UP) {
+                TickType periods = BasicTimer::advance(current);
+                setMissedPeriods(periods - 1);
+                this->recordLateness(lateness);
+                TickType calls = (runMode == TIMER_RUN_MODE_PERIODIC_CATCH_UP) ? periods : 1;
+                for (TickType i = 0; i < calls && hasStarted(); i++) {
+                    if (expiredCallback) {
                         expiredCallback();
                     }
-                } 
+                }
+                return periods;
             }
+
+            if (hasPreviouslyExpired()) return 0;
+            bitSet(stateFlags, ExpireFlagBit);
+            this->recordLateness(lateness);
+            if (runMode == TIMER_RUN_MODE_CONTINUOUS) {
+                this->reset(current);
+            }
+            if (expiredCallback) {
+                expiredCallback();
+            }
+            return 1;
         }
 
         /**
@@ -178,6 +264,43 @@ class CallbackTimer: public BasicTimer
             bitClear(stateFlags, ExpireFlagBit);
         }
 
+        /**
+         * @brief Resets the timer to a timestamp taken earlier with now().
+         * 
+         * @param current The timestamp to reset to
+         */
+        void reset(TickType current) {
+            BasicTimer::reset(current);
+            bitClear(stateFlags, ExpireFlagBit);
+        }
+
+        /**
+         * @brief The amount of time left until the callback is executed
+         *        in milliseconds.
+         * 
+         * @return unsigned long The remaining time in milliseconds, or 
+         *         NoDeadline if the timer is stopped or a one shot timer
+         *         has already expired.
+         */
+        unsigned long timeRemaining() const {
+            if (!hasStarted() || hasPreviouslyExpired()) return NoDeadline;
+            return BasicTimer::timeRemaining();
+        }
+
+        /**
+         * @brief The amount of time left until the callback is executed,
+         *        measured from a timestamp taken earlier with now().
+         * 
+         * @param current The timestamp to measure from
+         * @return unsigned long The remaining time in milliseconds, or 
+         *         NoDeadline if the timer is stopped or a one shot timer
+         *         has already expired.
+         */
+        unsigned long timeRemaining(TickType current) const {
+            if (!hasStarted() || hasPreviouslyExpired()) return NoDeadline;
+            return BasicTimer::timeRemaining(current);
+        }
+
         /**
          * @brief Sets the timer mode.  
          * 
@@ -199,6 +322,17 @@ class CallbackTimer: public BasicTimer
             return (stateFlags & (1 << StartFlagBit));
         }
 
+        /**
+         * @brief The number of whole periods that were skipped the last 
+         *        time a periodic timer expired, because run() was not 
+         *        called in time.  Saturates at 15.
+         * 
+         * @return uint8_t 
+         */
+        uint8_t missedPeriods() const {
+            return (stateFlags & MissedPeriodsMask) >> MissedPeriodsShift;
+        }
+
         /**
          * @brief Gets the current timer mode
          * 
@@ -234,12 +368,25 @@ class CallbackTimer: public BasicTimer
         bool hasPreviouslyExpired() const {
             return (stateFlags & (1 << ExpireFlagBit));
         }
+
     protected:
+        template <uint8_t CAPACITY> friend class TimerSnapshot;
+
         /**
          * @brief Constexpr mask for getting/setting the timer mode from 
          *        stateFlags
          */
-        static constexpr uint8_t TimerModeMask = 0x1;
+        static constexpr uint8_t TimerModeMask = 0x3;
+
+        /**
+         * @brief Constexpr mask for the missed period count in stateFlags
+         */
+        static constexpr uint8_t MissedPeriodsMask = 0x3C;
+
+        /**
+         * @brief Bit position in stateFlags of the missed period count
+         */
+        static constexpr uint8_t MissedPeriodsShift = 2;
 
         /**
          * @brief Bit position in stateFlags for the start flag
@@ -262,6 +409,13 @@ class CallbackTimer: public BasicTimer
          */
         OnExpireFunction expiredCallback;
 
+        /**
+         * @brief Stores the missed period count, saturating at 15
+         */
+        void setMissedPeriods(TickType missed) {
+            uint8_t count = (missed > 15) ? 15 : static_cast<uint8_t>(missed);
+            stateFlags = (stateFlags & ~MissedPeriodsMask) | (count << MissedPeriodsShift);
+        }
         
         /**
          * @brief Checks if the timer has expired.  The timer must
@@ -277,6 +431,45 @@ class CallbackTimer: public BasicTimer
                 return false;
             }
         }
+
+        /**
+         * @brief Checks if the timer had expired at a timestamp taken 
+         *        earlier with now().  The timer must have been started 
+         *        to have expired.
+         * 
+         * @param current The timestamp to check against
+         * @return bool True if expired, false if not
+         */
+        bool hasExpired(TickType current) const {
+            if (hasStarted()) {
+                return BasicTimer::hasExpired(current);
+            } else {
+                return false;
+            }
+        }
 };
 
+/**
+ * @brief A TCallbackTimer whose callback is a plain function, void f()
+ */
+typedef TCallbackTimer<> CallbackTimer;
+
+/**
+ * @brief A TCallbackTimer whose callback is a TimerDelegate, which can 
+ *        bind a member function, a context pointer or a small lambda
+ */
+typedef TCallbackTimer<TimerDelegate> DelegateTimer;
+
+/**
+ * @brief A CallbackTimer that records the lateness of every expiry in a 
+ *        TimerStats
+ */
+typedef TCallbackTimer<void(*)(), TimerStats> StatsCallbackTimer;
+
+/**
+ * @brief A DelegateTimer that records the lateness of every expiry in a 
+ *        TimerStats
+ */
+typedef TCallbackTimer<TimerDelegate, TimerStats> StatsDelegateTimer;
+
 #endif /* _BASIC_TIMER_CALLBACK_TIMER_H */
@@ -0,0 +1,271 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  DebounceBank.h
+//!  @brief DebounceBank class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_DEBOUNCE_BANK_H_
+#define _BASIC_TIMER_DEBOUNCE_BANK_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief Selects the smallest unsigned type with at least N bits
+ */
+template <bool FITS_8, bool FITS_16>
+struct DebounceBankWordSelect { typedef uint32_t Type; };
+
+template <bool FITS_16>
+struct DebounceBankWordSelect<true, FITS_16> { typedef uint8_t Type; };
+
+template <>
+struct DebounceBankWordSelect<false, true> { typedef uint16_t Type; };
+
+/**
+ * @brief Debounces up to 32 switch inputs at once, sampled on a single 
+ *        StaticTimer tick.
+ * 
+ *    Debouncing a switch the usual way takes a timer and a little state 
+ *    for every pin.  A DebounceBank instead keeps a 2 bit counter for every
+ *    input as two "vertical" words, bit i of each word holding one bit of 
+ *    input i's counter, so every input is debounced by the same handful of
+ *    bitwise operations.  An input's debounced state changes only after 
+ *    the raw reading has differed from it on SamplesToSettle consecutive 
+ *    samples; any sample that agrees restarts the count.
+ * 
+ *    Pass the raw readings packed into one word, bit i for input i, to 
+ *    update() on every loop().  A sample is taken every SAMPLE_TIME ticks, 
+ *    so a bounce is filtered out unless it lasts SamplesToSettle samples 
+ *    (20 ms with the default 5 ms sample time).  After each sample 
+ *    pressed() and released() give the inputs whose debounced state 
+ *    changed.  The whole bank for 8 inputs is six bytes plus the timer.
+ * 
+ *        DebounceBank<4> buttons(0x0F);       // four active low buttons
+ *        ...
+ *        uint8_t raw = digitalRead(2) | digitalRead(3) << 1 | 
+ *                      digitalRead(4) << 2 | digitalRead(5) << 3;
+ *        if (buttons.update(raw) && buttons.pressed() & 0x1) { ... }
+ * 
+ * @tparam N The number of inputs, 1 to 32.  The bitmask type is 8, 16 or 
+ *         32 bits wide to suit.
+ * @tparam SAMPLE_TIME The time between samples in clock ticks
+ * @tparam Clock The clock policy used for the sample timer
+ */
+template <uint8_t N, unsigned long SAMPLE_TIME = 5, typename Clock = MillisClock>
+class DebounceBank
+{
+    static_assert(N >= 1 && N <= 32, "DebounceBank holds 1 to 32 inputs");
+
+    public:
+        /**
+         * @brief The timestamp type of the clock policy
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief A bitmask with one bit per input, bit i for input i
+         */
+        typedef typename DebounceBankWordSelect<(N <= 8), (N <= 16)>::Type Mask;
+
+        /**
+         * @brief Consecutive disagreeing samples needed to change an input
+         */
+        static constexpr uint8_t SamplesToSettle = 4;
+
+        /**
+         * @brief Construct a new DebounceBank with every input released
+         * 
+         * @param activeLow Bitmask of inputs that read LOW when pressed, 
+         *        such as buttons wired to ground with INPUT_PULLUP
+         */
+        DebounceBank(Mask activeLow = 0): 
+                        inverted(activeLow), count0(~Mask(0)), count1(~Mask(0)), 
+                        debounced(0), pressedEdges(0), releasedEdges(0)
+        {
+            timer.reset();
+        };
+
+        /**
+         * @brief Takes a sample of the raw inputs if the sample time has 
+         *        passed; call every loop()
+         * 
+         * @param raw The raw readings, bit i for input i
+         * @return true if a sample was taken and an input changed state
+         */
+        bool update(Mask raw) { return update(raw, Clock::now()); };
+
+        /**
+         * @brief Takes a sample of the raw inputs if the sample time has 
+         *        passed at the given timestamp
+         * 
+         * @param raw The raw readings, bit i for input i
+         * @param current The current clock timestamp
+         * @return true if a sample was taken and an input changed state
+         */
+        bool update(Mask raw, TickType current)
+        {
+            if (!timer.hasExpired(current)) return false;
+            timer.advance(current);
+            return sample(raw);
+        };
+
+        /**
+         * @brief Takes a sample now, without the sample timer.  For use 
+         *        from a timer interrupt or a scheduler that already runs 
+         *        at the sample rate.
+         * 
+         * @param raw The raw readings, bit i for input i
+         * @return true if an input changed state
+         */
+        bool sample(Mask raw)
+        {
+            Mask changed = static_cast<Mask>((raw ^ inverted) ^ debounced);
+            count0 = static_cast<Mask>(~(count0 & changed));
+            count1 = static_cast<Mask>(count0 ^ (count1 & changed));
+            changed &= count0 & count1;
+            debounced ^= changed;
+            pressedEdges = changed & debounced;
+            releasedEdges = changed & ~debounced;
+            return changed != 0;
+        };
+
+        /**
+         * @brief The debounced state of every input, bit set when pressed
+         */
+        Mask state() const { return debounced; };
+
+        /**
+         * @brief The inputs that became pressed on the last sample
+         */
+        Mask pressed() const { return pressedEdges; };
+
+        /**
+         * @brief The inputs that became released on the last sample
+         */
+        Mask released() const { return releasedEdges; };
+
+        /**
+         * @brief Checks if one input is pressed, after debouncing
+         * 
+         * @param input The input number, less than N
+         */
+        bool isPressed(uint8_t input) const { return (debounced >> input) & 1; };
+
+        /**
+         * @brief Checks if one input became pressed on the last sample
+         * 
+         * @param input The input number, less than N
+         */
+        bool wasPressed(uint8_t input) const { return (pressedEdges >> input) & 1; };
+
+        /**
+         * @brief Checks if one input became released on the last sample
+         * 
+         * @param input The input number, less than N
+         */
+        bool wasReleased(uint8_t input) const { return (releasedEdges >> input) & 1; };
+
+        /**
+         * @brief The time until the next sample is due
+         * 
+         * @param current The current clock timestamp
+         */
+        TickType timeRemaining(TickType current) const { return timer.timeRemaining(current); };
+
+        /**
+         * @brief Forgets all history and sets the debounced state directly,
+         *        for instance from a first reading in setup()
+         * 
+         * @param raw The raw readings to accept as settled, bit i for input i
+         */
+        void reset(Mask raw = 0)
+        {
+            debounced = static_cast<Mask>(raw ^ inverted);
+            count0 = ~Mask(0);
+            count1 = ~Mask(0);
+            pressedEdges = 0;
+            releasedEdges = 0;
+            timer.reset();
+        };
+
+    protected:
+        /**
+         * @brief The sample tick
+         */
+        TStaticTimer<SAMPLE_TIME, Clock> timer;
+
+        /**
+         * @brief Inputs that read LOW when pressed
+         */
+        Mask inverted;
+
+        /**
+         * @brief Low and high bits of each input's vertical counter.  Both 
+         *        are set while the raw reading agrees with the debounced 
+         *        state, and count down to zero while it disagrees.
+         */
+        Mask count0;
+        Mask count1;
+
+        /**
+         * @brief Debounced state and last sample's edges
+         */
+        Mask debounced;
+        Mask pressedEdges;
+        Mask releasedEdges;
+};
+
+#endif /* _BASIC_TIMER_DEBOUNCE_BANK_H_ */
@@ -0,0 +1,288 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  InterruptTimers.h
+//!  @brief InterruptTimers class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_INTERRUPT_TIMERS_H_
+#define _BASIC_TIMER_INTERRUPT_TIMERS_H_
+
+#include "./TimerCore.h"
+#include "./TimerDelegate.h"
+#include "./SpscRing.h"
+
+/**
+ * @brief A set of timers whose expiry is detected by a periodic tick 
+ *        interrupt, with callbacks deferred to loop().
+ * 
+ *    With polled timers a callback can only be noticed when loop() reaches
+ *    run(), so a slow loop() delays every timer.  Here tick() is called 
+ *    from a hardware timer interrupt (or, on a host, a POSIX timer signal 
+ *    or a thread) and counts every armed timer down.  A timer that reaches 
+ *    zero is pushed onto a lock-free ring together with the tick it expired 
+ *    on, and dispatch() drains the ring from loop() and runs the callbacks.
+ *    Callbacks never run in interrupt context, and expiredAt() tells a 
+ *    callback exactly when its timer expired, however late loop() was.
+ * 
+ *    The timer state belongs to tick().  start() and stop() do not touch it;
+ *    they push commands onto a second ring that tick() applies at its next 
+ *    call, so no interrupts need to be disabled on either side.
+ * 
+ *    Times are in ticks.  A timer started with timeout T expires on the 
+ *    T + 1th tick after start(), so more than T whole tick periods have 
+ *    always passed.  Repeating timers reload from the interrupt and never 
+ *    drift, following the same rule as a CallbackTimer run on every tick: 
+ *    TIMER_RUN_MODE_CONTINUOUS restarts from the expiry and fires again 
+ *    T + 1 ticks later, while both periodic modes fire every T ticks.
+ * 
+ *    If loop() falls so far behind that the expiry ring fills, further 
+ *    expiries are dropped and counted by overflows().
+ * 
+ * @tparam CAPACITY The number of timer slots
+ * @tparam RING_SIZE The size of the expiry and command rings, a power of two
+ */
+template <uint8_t CAPACITY = 8, uint8_t RING_SIZE = 16>
+class InterruptTimers
+{
+    public:
+        /**
+         * @brief onExpire callback handler type
+         */
+        typedef TimerDelegate OnExpireFunction;
+
+        /**
+         * @brief Construct a new InterruptTimers with every slot stopped
+         */
+        InterruptTimers(): tickCount(0), overflowCount(0), dispatchTick(0)
+        {
+            for (uint8_t i = 0; i < CAPACITY; i++) {
+                slots[i].remaining = 0;
+                slots[i].period = 0;
+                slots[i].mode = TIMER_RUN_MODE_ONE_SHOT;
+                slots[i].armed = false;
+            }
+        };
+
+        InterruptTimers(const InterruptTimers&) = delete;
+        InterruptTimers& operator=(const InterruptTimers&) = delete;
+
+        /**
+         * @brief Assign the callback for a slot.  Called from loop() only.
+         * 
+         * @param slot The slot number, less than CAPACITY
+         * @param callback The onExpire callback
+         */
+        void onExpire(uint8_t slot, const OnExpireFunction& callback) { callbacks[slot] = callback; };
+
+        /**
+         * @brief Starts or restarts a slot at the next tick.  Called from 
+         *        loop() only.
+         * 
+         * @param slot The slot number, less than CAPACITY
+         * @param timeout The timeout in ticks
+         * @param mode The timer mode - defaults to TIMER_RUN_MODE_ONE_SHOT
+         * @return true if the request was queued
+         * @return false if the command ring is full (tick() is not running)
+         */
+        bool start(uint8_t slot, unsigned long timeout, TimerRunMode mode = TIMER_RUN_MODE_ONE_SHOT)
+        {
+            Command command = { timeout, slot, static_cast<uint8_t>(mode) };
+            return commands.push(command);
+        }
+
+        /**
+         * @brief Stops a slot at the next tick.  Called from loop() only.
+         *        An expiry already in the ring is still dispatched.
+         * 
+         * @param slot The slot number, less than CAPACITY
+         * @return true if the request was queued
+         * @return false if the command ring is full
+         */
+        bool stop(uint8_t slot)
+        {
+            Command command = { 0, slot, StopCommand };
+            return commands.push(command);
+        }
+
+        /**
+         * @brief Advances every armed slot by one tick.  Call this from the 
+         *        periodic tick interrupt, and from nowhere else.
+         */
+        void tick()
+        {
+            Command command;
+            while (commands.pop(command)) {
+                apply(command);
+            }
+            tickCount++;
+            for (uint8_t i = 0; i < CAPACITY; i++) {
+                Slot& slot = slots[i];
+                if (!slot.armed || --slot.remaining != 0) continue;
+                if (slot.mode == TIMER_RUN_MODE_ONE_SHOT) {
+                    slot.armed = false;
+                } else if (slot.mode == TIMER_RUN_MODE_CONTINUOUS) {
+                    slot.remaining = slot.period + 1;
+                } else {
+                    slot.remaining = (slot.period > 0) ? slot.period : 1;
+                }
+                Expiry expiry = { tickCount, i };
+                if (!expiries.push(expiry)) overflowCount = overflowCount + 1;
+            }
+        }
+
+        /**
+         * @brief Runs the callbacks of every timer that expired since the 
+         *        last call.  Should be called from the main loop.
+         * 
+         * @return uint8_t The number of callbacks run
+         */
+        uint8_t dispatch()
+        {
+            uint8_t count = 0;
+            Expiry expiry;
+            while (expiries.pop(expiry)) {
+                dispatchTick = expiry.tick;
+                if (callbacks[expiry.slot]) callbacks[expiry.slot]();
+                count++;
+            }
+            return count;
+        }
+
+        /**
+         * @brief The tick on which the timer whose callback is running 
+         *        expired, counted from the first tick().  Only meaningful 
+         *        inside a callback.
+         * 
+         * @return unsigned long 
+         */
+        unsigned long expiredAt() const { return dispatchTick; };
+
+        /**
+         * @brief The number of expiries dropped because the ring was full.
+         *        Safe to read from loop().
+         * 
+         * @return unsigned long 
+         */
+        unsigned long overflows() const 
+        { 
+            // Read until stable, in case tick() changed it part way through
+            unsigned long count;
+            do {
+                count = overflowCount;
+            } while (count != overflowCount);
+            return count;
+        };
+
+    protected:
+        /**
+         * @brief Command value that stops a slot instead of starting it
+         */
+        static constexpr uint8_t StopCommand = 0xFF;
+
+        /**
+         * @brief Timer state, owned by tick()
+         */
+        struct Slot
+        {
+            unsigned long remaining;
+            unsigned long period;
+            uint8_t mode;
+            bool armed;
+        };
+
+        /**
+         * @brief A start or stop request from loop() to tick()
+         */
+        struct Command
+        {
+            unsigned long timeout;
+            uint8_t slot;
+            uint8_t mode;
+        };
+
+        /**
+         * @brief An expiry passed from tick() to dispatch()
+         */
+        struct Expiry
+        {
+            unsigned long tick;
+            uint8_t slot;
+        };
+
+        Slot slots[CAPACITY];
+        OnExpireFunction callbacks[CAPACITY];
+        SpscRing<Command, RING_SIZE> commands;
+        SpscRing<Expiry, RING_SIZE> expiries;
+        unsigned long tickCount;
+        volatile unsigned long overflowCount;
+        unsigned long dispatchTick;
+
+        void apply(const Command& command)
+        {
+            if (command.slot >= CAPACITY) return;
+            Slot& slot = slots[command.slot];
+            if (command.mode == StopCommand) {
+                slot.armed = false;
+                return;
+            }
+            slot.period = command.timeout;
+            slot.remaining = command.timeout + 1;
+            slot.mode = command.mode;
+            slot.armed = true;
+        }
+};
+
+#endif /* _BASIC_TIMER_INTERRUPT_TIMERS_H_ */
@@ -0,0 +1,358 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  LoopMonitor.h
+//!  @brief LoopMonitor class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_LOOP_MONITOR_H_
+#define _BASIC_TIMER_LOOP_MONITOR_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief Measures the period of every loop() iteration and reports 
+ *        iterations that run over a budget.
+ * 
+ *    Every timer in this library is only as accurate as the rate at which
+ *    loop() comes round to run it.  A LoopMonitor called once at the top 
+ *    of loop() records the time since the previous call, keeping the 
+ *    worst period, the mean, a power-of-two histogram for percentiles, and
+ *    a count of iterations longer than the budget.  Each overrun also 
+ *    calls an optional callback with the offending period.
+ * 
+ *        LoopMonitor monitor(2000, onOverrun);     // 2ms budget
+ *        void setup() { monitor.begin(); }
+ *        void loop() {
+ *            monitor.run();
+ *            ...
+ *        }
+ * 
+ *    The histogram has a bucket for 0 ticks, then one for each power of 
+ *    two up to 2^14 and a last bucket for anything longer, so 
+ *    percentile() is accurate to within a factor of two; it never reports
+ *    more than the worst period seen.  Buckets are halved together when 
+ *    one of them fills, so a monitor can run for the lifetime of the 
+ *    device without the counts wrapping.
+ * 
+ * @tparam Clock The clock policy, microseconds by default since most 
+ *         loop() iterations are well under a millisecond
+ */
+template <typename Clock = MicrosClock>
+class TLoopMonitor
+{
+    public:
+        /**
+         * @brief The clock's timestamp type
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief Callback for an overrun, given the loop period in ticks
+         */
+        typedef void(*OnOverrunFunction)(unsigned long period);
+
+        /**
+         * @brief The number of histogram buckets
+         */
+        static constexpr uint8_t BucketCount = 16;
+
+        /**
+         * @brief Construct a new TLoopMonitor
+         * 
+         * @param budget The longest acceptable loop period in clock ticks
+         * @param callback Function to call for every overrun, or nullptr
+         */
+        TLoopMonitor(TickType budget = 1000, OnOverrunFunction callback = nullptr): 
+                        timer(budget), overrunCallback(callback), started(false)
+        {
+            clear();
+        };
+
+        /**
+         * @brief Starts measuring from now.  The first run() after 
+         *        begin() measures the time since begin().
+         */
+        void begin() { begin(Clock::now()); };
+
+        /**
+         * @brief Starts measuring from the given timestamp
+         * 
+         * @param current The current clock timestamp
+         */
+        void begin(TickType current)
+        {
+            timer.reset(current);
+            started = true;
+        };
+
+        /**
+         * @brief Stops measuring.  The next run() only sets the reference 
+         *        point, so a pause is not counted as an overrun.
+         */
+        void end() { started = false; };
+
+        /**
+         * @brief Records one loop() iteration; call once per loop()
+         * 
+         * @return true if the iteration ran over the budget
+         */
+        bool run() { return run(Clock::now()); };
+
+        /**
+         * @brief Records one loop() iteration at the given timestamp
+         * 
+         * @param current The current clock timestamp
+         * @return true if the iteration ran over the budget
+         */
+        bool run(TickType current)
+        {
+            if (!started) {
+                begin(current);
+                return false;
+            }
+            TickType period = timer.elapsedTime(current);
+            bool overrun = timer.hasExpired(current);
+            timer.reset(current);
+            record(period);
+            if (overrun) {
+                if (overrunCount != 0xFFFFFFFF) overrunCount++;
+                if (overrunCallback) overrunCallback(period);
+            }
+            return overrun;
+        };
+
+        /**
+         * @brief Discards everything recorded so far, keeping the budget
+         *        and the reference point
+         */
+        void clear()
+        {
+            iterationCount = 0;
+            overrunCount = 0;
+            periodSum = 0;
+            worstPeriod = 0;
+            for (uint8_t i = 0; i < BucketCount; i++) {
+                buckets[i] = 0;
+            }
+        };
+
+        /**
+         * @brief The longest acceptable loop period in clock ticks
+         */
+        TickType budget() const { return timer.timeout(); };
+
+        /**
+         * @brief Sets the longest acceptable loop period
+         * 
+         * @param budget The budget in clock ticks
+         */
+        void setBudget(TickType budget) { timer.setTimeout(budget); };
+
+        /**
+         * @brief Sets the function called on every overrun
+         * 
+         * @param callback The function, or nullptr for none
+         */
+        void onOverrun(OnOverrunFunction callback) { overrunCallback = callback; };
+
+        /**
+         * @brief The number of iterations recorded
+         */
+        uint32_t iterations() const { return iterationCount; };
+
+        /**
+         * @brief The number of iterations longer than the budget
+         */
+        uint32_t overruns() const { return overrunCount; };
+
+        /**
+         * @brief The longest loop period recorded, in clock ticks
+         */
+        TickType worst() const { return worstPeriod; };
+
+        /**
+         * @brief The mean loop period, rounded down, 0 if none recorded
+         */
+        TickType mean() const { 
+            return iterationCount ? static_cast<TickType>(periodSum / iterationCount) : 0; 
+        };
+
+        /**
+         * @brief An upper bound on the given percentile of loop periods
+         * 
+         *    Returns the top of the histogram bucket holding the 
+         *    percentile, capped at worst(), so percentile(99) of 700 
+         *    means at least 99% of iterations took 700 ticks or less.
+         * 
+         * @param percent The percentile, 0 to 100
+         * @return TickType The period bound in clock ticks
+         */
+        TickType percentile(uint8_t percent) const
+        {
+            uint32_t total = 0;
+            for (uint8_t i = 0; i < BucketCount; i++) total += buckets[i];
+            if (total == 0) return 0;
+            uint32_t rank = (total * percent + 99) / 100;
+            if (rank == 0) rank = 1;
+            uint32_t seen = 0;
+            for (uint8_t i = 0; i < BucketCount - 1; i++) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    TickType top = (i == 0) ? 0 : static_cast<TickType>((TickType(1) << i) - 1);
+                    return (top < worstPeriod) ? top : worstPeriod;
+                }
+            }
+            return worstPeriod;
+        };
+
+        /**
+         * @brief The count in one histogram bucket
+         * 
+         * @param bucket The bucket number, less than BucketCount
+         */
+        uint16_t bucket(uint8_t bucket) const { return buckets[bucket]; };
+
+        /**
+         * @brief Prints a one line summary, for example 
+         *        "loops=51200 overruns=3 mean=212 p99=511 worst=4810"
+         * 
+         * @param out The stream to print to, such as Serial
+         * @return size_t The number of characters printed
+         */
+        size_t printTo(Print& out) const
+        {
+            size_t count = out.print(F("loops="));
+            count += out.print(static_cast<unsigned long>(iterationCount));
+            count += out.print(F(" overruns="));
+            count += out.print(static_cast<unsigned long>(overrunCount));
+            count += out.print(F(" mean="));
+            count += out.print(static_cast<unsigned long>(mean()));
+            count += out.print(F(" p99="));
+            count += out.print(static_cast<unsigned long>(percentile(99)));
+            count += out.print(F(" worst="));
+            count += out.println(static_cast<unsigned long>(worstPeriod));
+            return count;
+        };
+
+    protected:
+        /**
+         * @brief Adds one period to the statistics
+         */
+        void record(TickType period)
+        {
+            if (iterationCount == 0xFFFFFFFF || periodSum > 0xFFFFFFFF - period) {
+                iterationCount >>= 1;
+                periodSum >>= 1;
+            }
+            iterationCount++;
+            periodSum += period;
+            if (period > worstPeriod) worstPeriod = period;
+
+            uint8_t bucket = 0;
+            while (period != 0 && bucket < BucketCount - 1) {
+                period >>= 1;
+                bucket++;
+            }
+            if (buckets[bucket] == 0xFFFF) {
+                for (uint8_t i = 0; i < BucketCount; i++) buckets[i] >>= 1;
+            }
+            buckets[bucket]++;
+        };
+
+        /**
+         * @brief Times the current iteration against the budget
+         */
+        TBasicTimer<Clock> timer;
+
+        /**
+         * @brief Overrun callback pointer storage
+         */
+        OnOverrunFunction overrunCallback;
+
+        /**
+         * @brief Iteration and overrun counts
+         */
+        uint32_t iterationCount;
+        uint32_t overrunCount;
+
+        /**
+         * @brief Sum of all periods, for the mean.  Halved with 
+         *        iterationCount when it would overflow.
+         */
+        uint32_t periodSum;
+
+        /**
+         * @brief Longest period seen
+         */
+        TickType worstPeriod;
+
+        /**
+         * @brief Power-of-two period histogram
+         */
+        uint16_t buckets[BucketCount];
+
+        /**
+         * @brief Set once there is a reference point to measure from
+         */
+        bool started;
+};
+
+/**
+ * @brief A loop monitor timed in microseconds
+ */
+typedef TLoopMonitor<> LoopMonitor;
+
+#endif /* _BASIC_TIMER_LOOP_MONITOR_H_ */
@@ -0,0 +1,290 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  PatternBlinker.h
+//!  @brief PatternBlinker class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_PATTERN_BLINKER_H_
+#define _BASIC_TIMER_PATTERN_BLINKER_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief Class that plays a sequence of on and off times stored in flash.
+ * 
+ *    A pattern is a PROGMEM array of step durations in milliseconds.  Even
+ *    numbered steps are on and odd numbered steps are off, so an SOS is 
+ *    
+ *        const uint16_t sos[] PROGMEM = {
+ *            150, 150, 150, 150, 150, 450,     // . . .
+ *            450, 150, 450, 150, 450, 450,     // - - -
+ *            150, 150, 150, 150, 150, 1500     // . . .
+ *        };
+ *        blinker.play(sos, 18);
+ * 
+ *    The blinker keeps only a pointer to the pattern and its position, so 
+ *    a pattern costs no RAM however long it is, and it is timed by a single
+ *    BasicTimer.  Each step starts exactly when the one before it ended, so 
+ *    a pattern does not drift even if run() is called late.
+ */
+class PatternBlinker
+{
+    public:
+        /**
+         * @brief Construct a new, stopped PatternBlinker
+         */
+        PatternBlinker(): pattern(nullptr), timer(0), length(0), step(0), repeatsLeft(0), stateFlags(0){};
+
+        /**
+         * @brief Starts playing a pattern from its first step, replacing any 
+         *        pattern already playing.
+         * 
+         * @param steps The PROGMEM array of step durations in milliseconds,
+         *        which must outlive the blinker
+         * @param count The number of steps in the pattern
+         * @param repeats The number of times to play the pattern before 
+         *        stopping, or 0 to repeat forever
+         */
+        void play(const uint16_t* steps, uint8_t count, uint8_t repeats = 0)
+        {
+            play(steps, count, repeats, timer.now());
+        }
+
+        /**
+         * @brief Starts playing a pattern from a timestamp taken earlier with 
+         *        BasicTimer::now().
+         * 
+         * @see play(const uint16_t*, uint8_t, uint8_t)
+         */
+        void play(const uint16_t* steps, uint8_t count, uint8_t repeats, BasicTimer::TickType current)
+        {
+            pattern = steps;
+            length = count;
+            repeatsLeft = repeats;
+            if (repeats == 0) {
+                bitSet(stateFlags, RepeatForeverFlagBit);
+            } else {
+                bitClear(stateFlags, RepeatForeverFlagBit);
+            }
+            if (count == 0) {
+                stop();
+                return;
+            }
+            bitSet(stateFlags, PlayingFlagBit);
+            step = 0;
+            timer.setTimeout(duration(0));
+            timer.reset(current);
+        }
+
+        /**
+         * @brief Stops the pattern and turns the blinker off
+         */
+        void stop() { bitClear(stateFlags, PlayingFlagBit); };
+
+        /**
+         * @brief Update the blinker based on elapsed time.
+         *        Should be called at least every loop.
+         */
+        void run()
+        {
+            run(timer.now());
+        }
+
+        /**
+         * @brief Update the blinker against a timestamp taken earlier with 
+         *        BasicTimer::now().
+         * 
+         *        If run() was late by several steps they are all skipped, 
+         *        up to one full pattern per call.
+         * 
+         * @param current The timestamp to update against
+         */
+        void run(BasicTimer::TickType current)
+        {
+            for (uint8_t i = 0; i < length && isPlaying() && timer.hasExpired(current); i++) {
+                // Start the next step where this one ended, not at current
+                BasicTimer::TickType late = timer.elapsedTime(current) - timer.timeout();
+                nextStep();
+                timer.reset(current - late);
+            }
+        }
+
+        /**
+         * @brief Gets if a pattern is playing
+         * 
+         * @return bool
+         */
+        bool isPlaying() const { return stateFlags & (1 << PlayingFlagBit); };
+
+        /**
+         * @brief The step of the pattern being played
+         * 
+         * @return uint8_t 
+         */
+        uint8_t currentStep() const { return step; };
+
+        /**
+         * @brief Get the current state of the blinker (does not update the blinker)
+         * 
+         * @return The current blinker state, false once the pattern stops
+         */
+        bool getState() const { return isPlaying() && !(step & 1); };
+
+        /**
+         * @brief Implicit casting to boolean gets the blinker state.
+         * 
+         * @return The current blinker state (true or false)
+         */
+        operator bool() const { return getState(); };
+
+        /**
+         * @brief The time until the current step ends, measured from a 
+         *        timestamp taken earlier with BasicTimer::now().
+         * 
+         * @param current The timestamp to measure from
+         * @return unsigned long The remaining time in milliseconds, or 
+         *         BasicTimer::NoDeadline if no pattern is playing
+         */
+        unsigned long timeRemaining(BasicTimer::TickType current) const
+        {
+            if (!isPlaying()) return BasicTimer::NoDeadline;
+            return timer.timeRemaining(current);
+        }
+
+        /**
+         * @brief The time until the blinker's state next changes, measured 
+         *        from a timestamp taken earlier with BasicTimer::now().
+         * 
+         *        Unlike timeRemaining() this skips over steps that do not 
+         *        change the state, such as zero length steps or the wrap 
+         *        from the last to the first step of an odd length pattern.
+         * 
+         * @param current The timestamp to measure from
+         * @return unsigned long The time in milliseconds, or 
+         *         BasicTimer::NoDeadline if the state will not change again
+         */
+        unsigned long timeUntilNextEdge(BasicTimer::TickType current) const
+        {
+            if (!isPlaying()) return BasicTimer::NoDeadline;
+            unsigned long wait = timer.timeRemaining(current);
+            bool state = getState();
+            uint8_t position = step;
+            uint8_t repeats = repeatsLeft;
+            for (uint8_t i = 0; i < length; i++) {
+                if (++position >= length) {
+                    position = 0;
+                    if (!(stateFlags & (1 << RepeatForeverFlagBit)) && --repeats == 0) {
+                        return state ? wait : BasicTimer::NoDeadline;
+                    }
+                }
+                unsigned long stepTime = duration(position);
+                if (stepTime != 0 && !(position & 1) != state) return wait;
+                wait += stepTime;
+            }
+            return BasicTimer::NoDeadline;
+        }
+
+        /**
+         * @brief The time until the blinker's state next changes.
+         * 
+         * @see timeUntilNextEdge(BasicTimer::TickType)
+         */
+        unsigned long timeUntilNextEdge() const { return timeUntilNextEdge(timer.now()); };
+
+    protected:
+        /**
+         * @brief Bit position in stateFlags for a pattern that repeats forever
+         */
+        static constexpr uint8_t RepeatForeverFlagBit = 5;
+
+        /**
+         * @brief Bit position in stateFlags for the playing flag
+         */
+        static constexpr uint8_t PlayingFlagBit = 6;
+
+        const uint16_t* pattern; //!< PROGMEM step durations
+        BasicTimer timer;
+        uint8_t length;
+        uint8_t step;
+        uint8_t repeatsLeft;
+        uint8_t stateFlags;
+
+        /**
+         * @brief Reads a step duration from flash
+         */
+        unsigned long duration(uint8_t index) const
+        {
+            return pgm_read_word(&pattern[index]);
+        }
+
+        /**
+         * @brief Moves to the next step, counting down repeats at the end 
+         *        of the pattern and stopping when they run out
+         */
+        void nextStep()
+        {
+            if (++step >= length) {
+                step = 0;
+                if (!(stateFlags & (1 << RepeatForeverFlagBit)) && --repeatsLeft == 0) {
+                    stop();
+                    return;
+                }
+            }
+            timer.setTimeout(duration(step));
+        }
+};
+
+#endif /* _BASIC_TIMER_PATTERN_BLINKER_H_ */
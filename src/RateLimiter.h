@@ -0,0 +1,391 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  RateLimiter.h
+//!  @brief TokenBucket and LeakyBucket class definitions
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_RATE_LIMITER_H_
+#define _BASIC_TIMER_RATE_LIMITER_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief A token bucket rate limiter that refills lazily from elapsed time.
+ * 
+ *    The bucket holds up to capacity tokens and gains refillTokens every 
+ *    refillInterval ticks.  tryAcquire(n) takes n tokens if there are 
+ *    that many, so up to capacity actions can happen in a burst and the 
+ *    long term rate is refillTokens per refillInterval.  Nothing has to 
+ *    poll the bucket: each call works out how many refills have happened 
+ *    since the time of the last refill, keeping the part of an interval 
+ *    that has already passed.  The elapsed time is the plain unsigned 
+ *    difference, so a bucket left idle for longer than half the clock 
+ *    range is still full when it is next used.  Timestamps passed in must
+ *    not be older than the one used by the previous call.
+ * 
+ *        TokenBucket logLimit(10, 1, 1000);  // bursts of 10, then 1 per second
+ *        ...
+ *        if (logLimit.tryAcquire()) Serial.println(message);
+ * 
+ *    All arithmetic is on integers.  The bucket starts full.
+ * 
+ * @tparam Clock The clock policy used for timestamps
+ */
+template <typename Clock = MillisClock>
+class TTokenBucket
+{
+    public:
+        /**
+         * @brief The timestamp type of the clock policy
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief Returned by timeUntilAvailable() when the request is 
+         *        larger than the bucket
+         */
+        static constexpr TickType NoDeadline = static_cast<TickType>(~TickType(0));
+
+        /**
+         * @brief Construct a new, full TTokenBucket
+         * 
+         * @param capacity The most tokens the bucket holds, the largest burst
+         * @param refillTokens The tokens added every refill interval
+         * @param refillInterval The time between refills in clock ticks, 
+         *        at least 1
+         */
+        TTokenBucket(uint16_t capacity = 1, uint16_t refillTokens = 1, TickType refillInterval = 1000):
+                        lastRefill(Clock::now()), interval(refillInterval ? refillInterval : 1), 
+                        tokenCount(capacity), tokenCapacity(capacity), tokensPerRefill(refillTokens)
+        {};
+
+        /**
+         * @brief Takes n tokens if they are available
+         * 
+         * @param n The number of tokens wanted
+         * @return true if the tokens were taken
+         * @return false if there are fewer than n, in which case none are taken
+         */
+        bool tryAcquire(uint16_t n = 1) { return tryAcquire(n, Clock::now()); };
+
+        /**
+         * @brief Takes n tokens if they are available at the given timestamp
+         */
+        bool tryAcquire(uint16_t n, TickType current)
+        {
+            refill(current);
+            if (tokenCount < n) return false;
+            tokenCount -= n;
+            return true;
+        };
+
+        /**
+         * @brief The time until n tokens will be available
+         * 
+         * @param n The number of tokens wanted
+         * @return TickType 0 if they are available now, NoDeadline if n is 
+         *         more than the capacity or the bucket never refills
+         */
+        TickType timeUntilAvailable(uint16_t n = 1) { return timeUntilAvailable(n, Clock::now()); };
+
+        /**
+         * @brief The time until n tokens will be available, measured from 
+         *        the given timestamp
+         */
+        TickType timeUntilAvailable(uint16_t n, TickType current)
+        {
+            refill(current);
+            if (tokenCount >= n) return 0;
+            if (n > tokenCapacity || tokensPerRefill == 0) return NoDeadline;
+            uint16_t missing = n - tokenCount;
+            TickType refills = static_cast<TickType>((missing + tokensPerRefill - 1) / tokensPerRefill);
+            return static_cast<TickType>(refills * interval - static_cast<TickType>(current - lastRefill));
+        };
+
+        /**
+         * @brief The number of tokens available now
+         */
+        uint16_t available() { return available(Clock::now()); };
+
+        /**
+         * @brief The number of tokens available at the given timestamp
+         */
+        uint16_t available(TickType current)
+        {
+            refill(current);
+            return tokenCount;
+        };
+
+        /**
+         * @brief The most tokens the bucket holds
+         */
+        uint16_t capacity() const { return tokenCapacity; };
+
+        /**
+         * @brief Refills the bucket to capacity
+         */
+        void fill()
+        {
+            tokenCount = tokenCapacity;
+            lastRefill = Clock::now();
+        };
+
+        /**
+         * @brief Empties the bucket
+         */
+        void drain()
+        {
+            tokenCount = 0;
+            lastRefill = Clock::now();
+        };
+
+    protected:
+        TickType lastRefill; //!< The time of the last refill
+        TickType interval;   //!< The time between refills
+
+        uint16_t tokenCount;
+        uint16_t tokenCapacity;
+        uint16_t tokensPerRefill;
+
+        /**
+         * @brief Adds the tokens for every whole interval since the last 
+         *        refill, up to a full bucket however long that was
+         */
+        void refill(TickType current)
+        {
+            // A bucket with no refill only ever empties
+            if (tokensPerRefill == 0) return;
+            TickType elapsed = static_cast<TickType>(current - lastRefill);
+            if (elapsed < interval) return;
+            if (tokenCount >= tokenCapacity) {
+                // A full bucket does not bank time towards the next token
+                lastRefill = current;
+                return;
+            }
+            TickType refills = elapsed / interval;
+            uint16_t room = tokenCapacity - tokenCount;
+            if (refills >= static_cast<TickType>((room + tokensPerRefill - 1) / tokensPerRefill)) {
+                tokenCount = tokenCapacity;
+                lastRefill = current;
+            } else {
+                tokenCount += static_cast<uint16_t>(refills * tokensPerRefill);
+                lastRefill = static_cast<TickType>(current - elapsed % interval);
+            }
+        };
+};
+
+/**
+ * @brief A leaky bucket rate limiter that spaces actions out evenly.
+ * 
+ *    Each unit acquired adds emitInterval ticks of "water" to the bucket, 
+ *    which drains continuously at one tick per tick.  tryAcquire(n) 
+ *    succeeds if the n units fit under the brim, set by capacity units.  
+ *    With a capacity of 1 actions are held to at most one per 
+ *    emitInterval with no burst at all; larger capacities allow that many
+ *    back to back before the spacing applies.  This is the Generic Cell 
+ *    Rate Algorithm used to police network traffic.
+ * 
+ *        LeakyBucket radioLimit(50);       // one transmission per 50 ms
+ *        ...
+ *        if (radioLimit.tryAcquire()) radio.send(packet);
+ * 
+ *    The level is kept as of the last update, and the water drained since 
+ *    is the plain unsigned time difference, so draining costs nothing, a 
+ *    bucket left idle for longer than half the clock range is still empty,
+ *    and tryAcquire() is a few integer operations with no division.  
+ *    capacity * emitInterval must fit in the clock's TickType; a larger 
+ *    capacity is reduced to the most units that fit.  Timestamps passed in 
+ *    must not be older than the one used by the previous call.  The bucket
+ *    starts empty.
+ * 
+ * @tparam Clock The clock policy used for timestamps
+ */
+template <typename Clock = MillisClock>
+class TLeakyBucket
+{
+    public:
+        /**
+         * @brief The timestamp type of the clock policy
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief Returned by timeUntilAvailable() when the request is 
+         *        larger than the bucket
+         */
+        static constexpr TickType NoDeadline = static_cast<TickType>(~TickType(0));
+
+        /**
+         * @brief Construct a new, empty TLeakyBucket
+         * 
+         * @param emitInterval The time one unit takes to drain, in clock 
+         *        ticks.  The long term rate is one unit per emitInterval.
+         * @param capacity The most units the bucket holds, the largest burst
+         */
+        TLeakyBucket(TickType emitInterval = 1000, uint16_t capacity = 1):
+                        lastUpdate(Clock::now()), level(0), interval(emitInterval), 
+                        unitCapacity(unitsThatFit(capacity, emitInterval)),
+                        brim(static_cast<TickType>(TickType(unitCapacity) * emitInterval))
+        {};
+
+        /**
+         * @brief Adds n units to the bucket if they fit
+         * 
+         * @param n The number of units
+         * @return true if the units were added and the action may proceed
+         * @return false if they would overflow, in which case none are added
+         */
+        bool tryAcquire(uint16_t n = 1) { return tryAcquire(n, Clock::now()); };
+
+        /**
+         * @brief Adds n units to the bucket if they fit at the given timestamp
+         */
+        bool tryAcquire(uint16_t n, TickType current)
+        {
+            // Checked before multiplying, so n * interval cannot wrap
+            if (n > unitCapacity) return false;
+            TickType currentLevel = levelAt(current);
+            TickType added = static_cast<TickType>(TickType(n) * interval);
+            if (currentLevel > brim - added) return false;
+            level = static_cast<TickType>(currentLevel + added);
+            lastUpdate = current;
+            return true;
+        };
+
+        /**
+         * @brief The time until n units will fit
+         * 
+         * @param n The number of units
+         * @return TickType 0 if they fit now, NoDeadline if n units are 
+         *         more than the capacity
+         */
+        TickType timeUntilAvailable(uint16_t n = 1) const { return timeUntilAvailable(n, Clock::now()); };
+
+        /**
+         * @brief The time until n units will fit, measured from the given 
+         *        timestamp
+         */
+        TickType timeUntilAvailable(uint16_t n, TickType current) const
+        {
+            if (n > unitCapacity) return NoDeadline;
+            TickType added = static_cast<TickType>(TickType(n) * interval);
+            TickType currentLevel = levelAt(current);
+            return (currentLevel > brim - added) ? static_cast<TickType>(currentLevel - (brim - added)) : 0;
+        };
+
+        /**
+         * @brief The time until the bucket is empty
+         */
+        TickType timeUntilEmpty(TickType current) const { return levelAt(current); };
+
+        /**
+         * @brief The time one unit takes to drain
+         */
+        TickType emitInterval() const { return interval; };
+
+        /**
+         * @brief Empties the bucket
+         */
+        void drain()
+        {
+            level = 0;
+            lastUpdate = Clock::now();
+        };
+
+    protected:
+        TickType lastUpdate;   //!< The time level was last set
+        TickType level;        //!< The bucket level at lastUpdate, in ticks
+        TickType interval;
+        uint16_t unitCapacity; //!< The capacity in units, reduced to fit
+        TickType brim;         //!< unitCapacity * interval, the level when full
+
+        /**
+         * @brief capacity, or the most units whose level fits in TickType
+         */
+        static uint16_t unitsThatFit(uint16_t capacity, TickType emitInterval)
+        {
+            if (emitInterval == 0 || capacity <= NoDeadline / emitInterval) return capacity;
+            return static_cast<uint16_t>(NoDeadline / emitInterval);
+        };
+
+        /**
+         * @brief The level at a timestamp, empty however long ago the last
+         *        update was
+         */
+        TickType levelAt(TickType current) const
+        {
+            TickType elapsed = static_cast<TickType>(current - lastUpdate);
+            return (elapsed < level) ? static_cast<TickType>(level - elapsed) : 0;
+        };
+};
+
+template <typename Clock>
+constexpr typename TTokenBucket<Clock>::TickType TTokenBucket<Clock>::NoDeadline;
+
+template <typename Clock>
+constexpr typename TLeakyBucket<Clock>::TickType TLeakyBucket<Clock>::NoDeadline;
+
+/**
+ * @brief A token bucket timed in milliseconds
+ */
+typedef TTokenBucket<> TokenBucket;
+
+/**
+ * @brief A leaky bucket timed in milliseconds
+ */
+typedef TLeakyBucket<> LeakyBucket;
+
+#endif /* _BASIC_TIMER_RATE_LIMITER_H_ */
@@ -0,0 +1,171 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  SpscRing.h
+//!  @brief SpscRing class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_SPSC_RING_H_
+#define _BASIC_TIMER_SPSC_RING_H_
+
+#include <stdint.h>
+
+/**
+ * @brief A fixed size, lock-free ring buffer for passing values from one 
+ *        producer to one consumer, such as from an interrupt to loop().
+ * 
+ *    Only the producer calls push() and only the consumer calls pop(), so 
+ *    each index has a single writer and no interrupts need to be disabled.
+ *    The indices are single bytes, which AVR reads and writes atomically; 
+ *    on other targets they are accessed with acquire/release ordering so 
+ *    the ring also works between two threads.
+ * 
+ * @tparam T The element type, copied in and out by value
+ * @tparam SIZE The number of elements, a power of two from 2 to 128
+ */
+template <typename T, uint8_t SIZE>
+class SpscRing
+{
+    static_assert(SIZE >= 2 && SIZE <= 128 && (SIZE & (SIZE - 1)) == 0, 
+                  "SpscRing size must be a power of two from 2 to 128");
+
+    public:
+        /**
+         * @brief Construct a new, empty ring
+         */
+        SpscRing(): head(0), tail(0) {};
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        /**
+         * @brief The maximum number of elements the ring can hold
+         */
+        static constexpr uint8_t capacity() { return SIZE; };
+
+        /**
+         * @brief Adds a value.  Producer only.
+         * 
+         * @param value The value to copy in
+         * @return true if the value was added
+         * @return false if the ring was full
+         */
+        bool push(const T& value)
+        {
+            uint8_t writeIndex = head;
+            if (static_cast<uint8_t>(writeIndex - loadAcquire(tail)) >= SIZE) return false;
+            items[writeIndex & Mask] = value;
+            storeRelease(head, static_cast<uint8_t>(writeIndex + 1));
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest value.  Consumer only.
+         * 
+         * @param value Set to the removed value
+         * @return true if a value was removed
+         * @return false if the ring was empty
+         */
+        bool pop(T& value)
+        {
+            uint8_t readIndex = tail;
+            if (readIndex == loadAcquire(head)) return false;
+            value = items[readIndex & Mask];
+            storeRelease(tail, static_cast<uint8_t>(readIndex + 1));
+            return true;
+        }
+
+        /**
+         * @brief Checks if the ring is empty.  Exact for the consumer, a 
+         *        hint for the producer.
+         */
+        bool empty() const { return loadAcquire(tail) == loadAcquire(head); };
+
+        /**
+         * @brief The number of values waiting.  Exact for neither side, 
+         *        as the other side may be adding or removing.
+         */
+        uint8_t size() const { return static_cast<uint8_t>(loadAcquire(head) - loadAcquire(tail)); };
+
+    protected:
+        static constexpr uint8_t Mask = SIZE - 1;
+
+        T items[SIZE];
+        volatile uint8_t head; //!< Next write position, written by the producer
+        volatile uint8_t tail; //!< Next read position, written by the consumer
+
+        static uint8_t loadAcquire(const volatile uint8_t& index)
+        {
+#if defined(__AVR__)
+            uint8_t value = index;
+            asm volatile("" : : : "memory");
+            return value;
+#else
+            return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+#endif
+        }
+
+        static void storeRelease(volatile uint8_t& index, uint8_t value)
+        {
+#if defined(__AVR__)
+            asm volatile("" : : : "memory");
+            index = value;
+#else
+            __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+#endif
+        }
+};
+
+#endif /* _BASIC_TIMER_SPSC_RING_H_ */
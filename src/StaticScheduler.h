@@ -0,0 +1,426 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  StaticScheduler.h
+//!  @brief StaticScheduler class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_STATIC_SCHEDULER_H_
+#define _BASIC_TIMER_STATIC_SCHEDULER_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief A periodic task for a StaticScheduler
+ * 
+ * @tparam PERIOD The task period in milliseconds
+ * @tparam FUNCTION The function to run every period
+ * @tparam OFFSET When in each period the task runs, in milliseconds from 
+ *         the start of the period.  Staggering tasks with offsets keeps 
+ *         them from all falling due in the same tick.
+ */
+template <unsigned long PERIOD, void (*FUNCTION)(), unsigned long OFFSET = 0>
+struct StaticTask
+{
+    static_assert(PERIOD > 0, "StaticTask period must be at least 1ms");
+    static_assert(OFFSET < PERIOD, "StaticTask offset must be less than its period");
+
+    static constexpr unsigned long Period = PERIOD;
+    static constexpr unsigned long Offset = OFFSET;
+
+    static void run() { FUNCTION(); }
+};
+
+namespace StaticSchedulerDetail
+{
+    constexpr unsigned long gcd(unsigned long a, unsigned long b) { return b == 0 ? a : gcd(b, a % b); }
+
+    constexpr unsigned long lcm(unsigned long a, unsigned long b) { return a / gcd(a, b) * b; }
+
+    /**
+     * @brief True if lcm(a, b) does not fit in 32 bits, the size of an 
+     *        unsigned long on AVR
+     */
+    constexpr bool lcmOverflows(unsigned long a, unsigned long b) { return a / gcd(a, b) > 0xFFFFFFFFUL / b; }
+
+    constexpr unsigned int larger(unsigned int a, unsigned int b) { return a > b ? a : b; }
+
+    constexpr unsigned int lowestBit(uint32_t mask, unsigned int bit = 0) 
+    { 
+        return ((mask >> bit) & 1) ? bit : lowestBit(mask, bit + 1); 
+    }
+
+    constexpr unsigned int bitCount(uint32_t mask) { return mask == 0 ? 0 : 1 + bitCount(mask & (mask - 1)); }
+
+    /**
+     * @brief A pack of 0 to N - 1, for expanding over task numbers
+     */
+    template <unsigned int... INDICES>
+    struct Indices {};
+
+    template <unsigned int N, unsigned int... INDICES>
+    struct MakeIndices
+    {
+        typedef typename MakeIndices<N - 1, N - 1, INDICES...>::Type Type;
+    };
+
+    template <unsigned int... INDICES>
+    struct MakeIndices<0, INDICES...>
+    {
+        typedef Indices<INDICES...> Type;
+    };
+
+    /**
+     * @brief Compile time facts about a set of StaticTasks, by recursion 
+     *        over the task list
+     */
+    template <typename... Tasks>
+    struct TaskSet;
+
+    template <>
+    struct TaskSet<>
+    {
+        static constexpr unsigned long Gcd = 0;
+        static constexpr unsigned long Lcm = 1;
+        static constexpr bool LcmOverflow = false;
+        static constexpr unsigned long periodOf(unsigned int) { return 1; }
+        static constexpr unsigned long offsetOf(unsigned int) { return 0; }
+    };
+
+    template <typename First, typename... Rest>
+    struct TaskSet<First, Rest...>
+    {
+        static constexpr unsigned long Gcd = gcd(gcd(First::Period, First::Offset), TaskSet<Rest...>::Gcd);
+        static constexpr unsigned long Lcm = lcm(First::Period, TaskSet<Rest...>::Lcm);
+        static constexpr bool LcmOverflow = TaskSet<Rest...>::LcmOverflow || lcmOverflows(First::Period, TaskSet<Rest...>::Lcm);
+
+        static constexpr unsigned long periodOf(unsigned int index) 
+        { 
+            return index == 0 ? First::Period : TaskSet<Rest...>::periodOf(index - 1); 
+        }
+
+        static constexpr unsigned long offsetOf(unsigned int index) 
+        { 
+            return index == 0 ? First::Offset : TaskSet<Rest...>::offsetOf(index - 1); 
+        }
+    };
+
+    /**
+     * @brief The most tasks ever due in the same tick, worked out from the 
+     *        periods and offsets rather than by walking the hyperperiod.
+     * 
+     *    Two tasks are ever due together exactly when their offsets agree 
+     *    modulo the GCD of their periods, and by the generalised Chinese 
+     *    remainder theorem a group of tasks is ever due together exactly 
+     *    when every pair in it is.  So the answer is the size of the largest
+     *    such group (a maximum clique of the "can collide" graph), found by
+     *    branching on one task at a time.  A task that can collide with 
+     *    every remaining task is always taken, so the usual case of 
+     *    unstaggered or lightly staggered tasks needs no branching at all, 
+     *    and a branch that cannot beat the best group found so far is not 
+     *    explored.
+     */
+    template <typename Set, unsigned int COUNT, typename Indices = typename MakeIndices<COUNT>::Type>
+    struct Collisions;
+
+    template <typename Set, unsigned int COUNT, unsigned int... INDICES>
+    struct Collisions<Set, COUNT, Indices<INDICES...>>
+    {
+        static constexpr bool collide(unsigned int a, unsigned int b)
+        {
+            return Set::offsetOf(a) % gcd(Set::periodOf(a), Set::periodOf(b)) == 
+                   Set::offsetOf(b) % gcd(Set::periodOf(a), Set::periodOf(b));
+        }
+
+        /**
+         * @brief Bit i set for every other task i that can collide with task
+         */
+        static constexpr uint32_t neighboursOf(unsigned int task, unsigned int other = 0)
+        {
+            return (other == COUNT) ? 0 : 
+                   (((other != task && collide(task, other)) ? (uint32_t(1) << other) : 0) | 
+                    neighboursOf(task, other + 1));
+        }
+
+        /**
+         * @brief neighboursOf() for every task, worked out once
+         */
+        static constexpr uint32_t Neighbours[COUNT] = { neighboursOf(INDICES)... };
+
+        static constexpr unsigned int largest(uint32_t candidates)
+        {
+            return (candidates == 0) ? 0 : 
+                   largestWith(candidates & ~(uint32_t(1) << lowestBit(candidates)), 
+                               Neighbours[lowestBit(candidates)]);
+        }
+
+        /**
+         * @brief The largest group among candidates plus one task, given 
+         *        that task's neighbours
+         */
+        static constexpr unsigned int largestWith(uint32_t others, uint32_t taskNeighbours)
+        {
+            return ((others & taskNeighbours) == others) ? 1 + largest(others) : 
+                   largerOf(largest(others), others & taskNeighbours);
+        }
+
+        /**
+         * @brief The larger of a group size already found and the largest 
+         *        group of one task plus some of its neighbours
+         */
+        static constexpr unsigned int largerOf(unsigned int found, uint32_t taskNeighbours)
+        {
+            return (1 + bitCount(taskNeighbours) <= found) ? found : larger(found, 1 + largest(taskNeighbours));
+        }
+
+        static constexpr unsigned int Most = largest((COUNT == 32) ? ~uint32_t(0) : (uint32_t(1) << COUNT) - 1);
+    };
+
+    template <typename Set, unsigned int COUNT, unsigned int... INDICES>
+    constexpr uint32_t Collisions<Set, COUNT, Indices<INDICES...>>::Neighbours[COUNT];
+}
+
+/**
+ * @brief Runs a fixed set of periodic tasks from a single StaticTimer, with
+ *        the schedule worked out at compile time.
+ * 
+ *        void readSensors();
+ *        void updateDisplay();
+ *        StaticScheduler<StaticTask<100, readSensors>, 
+ *                        StaticTask<250, updateDisplay, 50>> scheduler;
+ * 
+ *    The base tick is the greatest common divisor of every period and 
+ *    offset (50ms above), and the pattern repeats every hyperperiod, the 
+ *    least common multiple of the periods (500ms).  run() makes one timer 
+ *    check per loop.  On each base tick every task counts down the ticks to
+ *    its next run and is reloaded with a compile time constant, so there is
+ *    no division on the hot path, which matters on AVR where a 32 bit 
+ *    division costs hundreds of cycles.  A tick that was missed because 
+ *    loop() was slow is still dispatched, up to one hyperperiod of them.
+ * 
+ *    MaxDuePerTick, the most tasks that ever fall due in the same tick, is
+ *    also computed at compile time, from the periods and offsets taken in 
+ *    pairs, so its cost does not depend on the length of the hyperperiod.
+ *    TStaticScheduler static_asserts that it is no more than MAX_DUE; 
+ *    stagger tasks with offsets to bring it down.  StaticScheduler sets no
+ *    limit.  Both forms static_assert that the hyperperiod fits in 32 
+ *    bits, which periods with large coprime factors can overflow.
+ * 
+ * @tparam MAX_DUE The most tasks allowed to be due in one tick, or 0 for 
+ *         no limit
+ * @tparam Tasks The StaticTasks to run
+ */
+template <unsigned int MAX_DUE, typename... Tasks>
+class TStaticScheduler
+{
+    typedef StaticSchedulerDetail::TaskSet<Tasks...> Set;
+
+    static_assert(sizeof...(Tasks) > 0, "StaticScheduler needs at least one task");
+    static_assert(sizeof...(Tasks) <= 32, "StaticScheduler runs at most 32 tasks");
+    static_assert(!Set::LcmOverflow, "StaticScheduler hyperperiod does not fit in 32 bits");
+
+    public:
+        /**
+         * @brief The base tick in milliseconds, the GCD of every period and offset
+         */
+        static constexpr unsigned long Tick = Set::Gcd;
+
+        /**
+         * @brief The time in milliseconds after which the schedule repeats
+         */
+        static constexpr unsigned long HyperPeriod = Set::Lcm;
+
+        /**
+         * @brief The number of base ticks in one hyperperiod
+         */
+        static constexpr unsigned long TicksPerHyperPeriod = HyperPeriod / Tick;
+
+        /**
+         * @brief The most tasks due in any single tick
+         */
+        static constexpr unsigned int MaxDuePerTick = StaticSchedulerDetail::Collisions<Set, sizeof...(Tasks)>::Most;
+
+        static_assert(MAX_DUE == 0 || MaxDuePerTick <= MAX_DUE, "Too many StaticScheduler tasks can fall due in the same tick");
+
+        /**
+         * @brief Construct a new StaticScheduler.  The first tick is a 
+         *        base tick after construction or begin().
+         */
+        TStaticScheduler() { restart(false); };
+
+        /**
+         * @brief Restarts the schedule from tick 0, when every task with a
+         *        zero offset is due.
+         */
+        void begin()
+        {
+            timer.reset();
+            restart(true);
+        }
+
+        /**
+         * @brief Runs the tasks due since the last call.  Should be 
+         *        called at least every loop.
+         * 
+         * @return unsigned long The number of base ticks dispatched
+         */
+        unsigned long run() { return run(timer.now()); };
+
+        /**
+         * @brief Runs the tasks due at a timestamp taken earlier with 
+         *        BasicTimer::now().
+         * 
+         * @param current The timestamp to run against
+         * @return unsigned long The number of base ticks dispatched
+         */
+        unsigned long run(BasicTimer::TickType current)
+        {
+            unsigned long ticks = timer.advance(current);
+            if (ticks > TicksPerHyperPeriod) {
+                // Whole hyperperiods leave every countdown where it was
+                skip((ticks - TicksPerHyperPeriod) % TicksPerHyperPeriod);
+                ticks = TicksPerHyperPeriod;
+            }
+            for (unsigned long i = 0; i < ticks; i++) {
+                dispatch();
+            }
+            return ticks;
+        }
+
+        /**
+         * @brief The time until the next base tick, measured from a 
+         *        timestamp taken earlier with BasicTimer::now().
+         * 
+         * @param current The timestamp to measure from
+         * @return unsigned long The time in milliseconds
+         */
+        unsigned long timeRemaining(BasicTimer::TickType current) const { return timer.timeRemaining(current); };
+
+    protected:
+        StaticTimer<Tick> timer;
+        unsigned long countdown[sizeof...(Tasks)]; //!< Base ticks until each task is next due
+
+        template <typename T>
+        static void restartTask(unsigned long& remaining, bool runDue)
+        {
+            if (T::Offset == 0) {
+                remaining = T::Period / Tick;
+                if (runDue) T::run();
+            } else {
+                remaining = T::Offset / Tick;
+            }
+        }
+
+        template <typename T>
+        static void countDown(unsigned long& remaining)
+        {
+            if (--remaining != 0) return;
+            remaining = T::Period / Tick;
+            T::run();
+        }
+
+        template <typename T>
+        static void skipTask(unsigned long& remaining, unsigned long ticks)
+        {
+            if (remaining > ticks) {
+                remaining -= ticks;
+            } else {
+                remaining = T::Period / Tick - (ticks - remaining) % (T::Period / Tick);
+            }
+        }
+
+        void restart(bool runDue)
+        {
+            unsigned long* remaining = countdown;
+            int expand[] = { 0, (restartTask<Tasks>(*remaining++, runDue), 0)... };
+            (void)expand;
+        }
+
+        void dispatch()
+        {
+            // Expands to one countDown<T>() per task, in order
+            unsigned long* remaining = countdown;
+            int expand[] = { 0, (countDown<Tasks>(*remaining++), 0)... };
+            (void)expand;
+        }
+
+        void skip(unsigned long ticks)
+        {
+            unsigned long* remaining = countdown;
+            int expand[] = { 0, (skipTask<Tasks>(*remaining++, ticks), 0)... };
+            (void)expand;
+        }
+};
+
+template <unsigned int MAX_DUE, typename... Tasks>
+constexpr unsigned long TStaticScheduler<MAX_DUE, Tasks...>::Tick;
+
+template <unsigned int MAX_DUE, typename... Tasks>
+constexpr unsigned long TStaticScheduler<MAX_DUE, Tasks...>::HyperPeriod;
+
+template <unsigned int MAX_DUE, typename... Tasks>
+constexpr unsigned long TStaticScheduler<MAX_DUE, Tasks...>::TicksPerHyperPeriod;
+
+template <unsigned int MAX_DUE, typename... Tasks>
+constexpr unsigned int TStaticScheduler<MAX_DUE, Tasks...>::MaxDuePerTick;
+
+/**
+ * @brief A TStaticScheduler with no limit on the number of tasks due in 
+ *        one tick
+ */
+template <typename... Tasks>
+using StaticScheduler = TStaticScheduler<0, Tasks...>;
+
+#endif /* _BASIC_TIMER_STATIC_SCHEDULER_H_ */
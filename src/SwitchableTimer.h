@@ -59,7 +59,7 @@
 #ifndef _SWITCHABLE_TIMER_H_
 #define _SWITCHABLE_TIMER_H_
 
-#include "./BasicTimer.h"
+#include "./TimerCore.h"
 
 class SwitchableTimer: public BasicTimer
 {
@@ -97,6 +97,16 @@ class SwitchableTimer: public BasicTimer
             }
             else return this->hasExpired();
         }
+
+        bool hasFinished(TickType current)
+        {
+            if (!enabled)
+            {
+                this->reset(current);
+                return false;
+            }
+            else return this->hasExpired(current);
+        }
     protected:
         bool enabled;
 };
@@ -138,6 +148,16 @@ class StaticSwitchableTimer: public StaticTimer<TIMEOUT>
             }
             else return this->hasExpired();
         }
+
+        bool hasFinished(typename StaticTimer<TIMEOUT>::TickType current)
+        {
+            if (!enabled)
+            {
+                this->reset(current);
+                return false;
+            }
+            else return this->hasExpired(current);
+        }
     protected:
         bool enabled;
 };
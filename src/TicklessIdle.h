@@ -0,0 +1,206 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TicklessIdle.h
+//!  @brief TicklessIdle class definitions
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+#ifndef _BASIC_TIMER_TICKLESS_IDLE_H_
+#define _BASIC_TIMER_TICKLESS_IDLE_H_
+
+#include "./TimerCore.h"
+#include "./TimerGroup.h"
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+/**
+ * @brief Sleeps until the earliest deadline of a set of registered timers.
+ * 
+ *    Instead of spinning loop() and checking every timer, call idle() once 
+ *    per loop.  It works out how long it is until the first registered timer,
+ *    blinker or queue is due, hands that time to a sleep hook, and then runs
+ *    every registered CallbackTimer, blinker and TimerQueue so that whatever
+ *    came due is serviced.  Plain BasicTimers and StaticTimers have nothing
+ *    to run, but they still limit the sleep time so that their hasExpired() 
+ *    checks in loop() happen on time.
+ * 
+ *    The sleep hook does the platform specific work (an AVR sleep mode, 
+ *    an RTOS delay, nanosleep() on a host) and may return early, for example
+ *    when an interrupt wakes the processor.
+ * 
+ *    Objects are registered with add() exactly as for a TimerGroup, and 
+ *    must outlive the TicklessIdle they are added to.
+ * 
+ * @tparam CAPACITY The maximum number of registered objects
+ * @see TimerGroup
+ */
+template <uint8_t CAPACITY = 8>
+class TicklessIdle: public TimerGroup<CAPACITY>
+{
+    public:
+        /**
+         * @brief Sleep hook type, called with the time to sleep in milliseconds
+         */
+        typedef void(*SleepFunction)(unsigned long duration);
+
+        /**
+         * @brief Construct a new TicklessIdle object
+         * 
+         * @param sleepHook The function called to sleep, nullptr to never sleep
+         */
+        TicklessIdle(SleepFunction sleepHook = nullptr): 
+            sleepFunction(sleepHook), 
+            minimumSleep(1),
+            maximumSleep(1000),
+            sleepCounter(0){};
+
+        /**
+         * @brief Assign the function used to sleep
+         * 
+         * @param sleepHook The sleep function, nullptr to never sleep
+         */
+        void onSleep(SleepFunction sleepHook){ sleepFunction = sleepHook; };
+
+        /**
+         * @brief Set the range of sleep times that will be passed to the 
+         *        sleep hook.
+         * 
+         *        Shorter waits are not worth sleeping for and are skipped. 
+         *        Longer waits are capped, which also bounds the sleep 
+         *        when nothing is pending.
+         * 
+         * @param minimum The shortest time worth sleeping for in milliseconds
+         * @param maximum The longest time to sleep for in milliseconds
+         */
+        void setSleepLimits(unsigned long minimum, unsigned long maximum)
+        {
+            minimumSleep = minimum;
+            maximumSleep = maximum;
+        }
+
+        /**
+         * @brief The time in milliseconds until the first registered object
+         *        is due.
+         * 
+         * @return unsigned long The time in milliseconds, 0 if something is 
+         *         already due, or BasicTimer::NoDeadline if nothing is pending
+         */
+        unsigned long timeUntilNext()
+        {
+            this->snapshot = BasicTimer::now();
+            return TimerGroup<CAPACITY>::timeUntilNext();
+        }
+
+        /**
+         * @brief Runs every registered object that can be run
+         */
+        void service() { this->run(); };
+
+        /**
+         * @brief Sleeps until the first registered object is due, then 
+         *        services everything.  Should be called from the main loop.
+         * 
+         * @return unsigned long The time passed to the sleep hook in 
+         *         milliseconds, or 0 if it was not called.
+         */
+        unsigned long idle()
+        {
+            unsigned long duration = timeUntilNext();
+            if (duration > maximumSleep) duration = maximumSleep;
+            if (sleepFunction == nullptr || duration < minimumSleep) {
+                duration = 0;
+            } else {
+                sleepFunction(duration);
+                sleepCounter++;
+            }
+            service();
+            return duration;
+        }
+
+        /**
+         * @brief The number of times the sleep hook has been called
+         * 
+         * @return unsigned long 
+         */
+        unsigned long sleepCount() const { return sleepCounter; };
+
+    protected:
+        SleepFunction sleepFunction;
+        unsigned long minimumSleep;
+        unsigned long maximumSleep;
+        unsigned long sleepCounter;
+};
+
+#if defined(__linux__)
+/**
+ * @brief TicklessIdle sleep hook for Linux hosts, backed by nanosleep()
+ * 
+ *    This waits in real time.  With the virtual clock of the host build in
+ *    extras/host, where millis() only moves when told to, use 
+ *    ArduinoHost::idleSleep instead.
+ * 
+ * @param duration The time to sleep in milliseconds
+ */
+inline void nanosleepIdle(unsigned long duration)
+{
+    struct timespec request;
+    request.tv_sec = duration / 1000;
+    request.tv_nsec = (duration % 1000) * 1000000L;
+    nanosleep(&request, nullptr);
+}
+#endif
+
+#endif /* _BASIC_TIMER_TICKLESS_IDLE_H_ */
@@ -0,0 +1,300 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimedStateMachine.h
+//!  @brief TimedStateMachine class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_TIMED_STATE_MACHINE_H_
+#define _BASIC_TIMER_TIMED_STATE_MACHINE_H_
+
+#include "./TimerCore.h"
+
+class TimedStateMachine;
+
+/**
+ * @brief One row of a TimedStateMachine table
+ */
+struct TimedState
+{
+    /**
+     * @brief Time in milliseconds to stay in the state before moving to 
+     *        next, or TimedStateMachine::Forever to wait for transition()
+     */
+    unsigned long timeout;
+
+    /**
+     * @brief The state entered when the timeout passes
+     */
+    uint8_t next;
+
+    /**
+     * @brief Called on entering the state, may be nullptr
+     */
+    void (*onEnter)(TimedStateMachine& machine);
+};
+
+/**
+ * @brief A finite state machine whose states each last a fixed time, 
+ *        declared in a constant table and driven by a single BasicTimer.
+ * 
+ *    Each row of the table gives a state's timeout, the state that follows
+ *    it, and an entry action.  The table can be shared by any number of 
+ *    machines and can live in PROGMEM, so a machine only needs RAM for its 
+ *    timer, its current state and a context pointer that entry actions can 
+ *    use to tell machines apart.  run() costs one timer check per loop; the 
+ *    table is only read when a state is entered.
+ * 
+ *        const TimedState blinkTwice[] PROGMEM = {
+ *            { 200, 1, ledOn },      // 0: on for 200ms, then 1
+ *            { 200, 2, ledOff },     // 1: off for 200ms, then 2
+ *            { 200, 3, ledOn },      // 2: on for 200ms, then 3
+ *            { TimedStateMachine::Forever, 3, ledOff }   // 3: off until transition()
+ *        };
+ *        TimedStateMachine machine(blinkTwice, 4, TIMED_STATE_TABLE_PROGMEM);
+ * 
+ *    A state is entered when its timeout passes as measured from when the 
+ *    previous state was entered, the same as resetting a BasicTimer when it
+ *    expires.  Entry actions may call transition() to move elsewhere.
+ */
+class TimedStateMachine
+{
+    public:
+        /**
+         * @brief Where the state table is stored
+         */
+        enum TableLocation
+        {
+            TIMED_STATE_TABLE_RAM = 0,
+            TIMED_STATE_TABLE_PROGMEM = 1
+        };
+
+        /**
+         * @brief Timeout for a state that only ends through transition()
+         */
+        static constexpr unsigned long Forever = BasicTimer::NoDeadline;
+
+        /**
+         * @brief Construct a new TimedStateMachine.  It does nothing until 
+         *        begin() is called.
+         * 
+         * @param table The state table, which must outlive the machine
+         * @param count The number of states in the table
+         * @param location Whether the table is in RAM or PROGMEM
+         * @param context A pointer the entry actions can read with context()
+         */
+        TimedStateMachine(const TimedState* table, uint8_t count, 
+                          TableLocation location = TIMED_STATE_TABLE_RAM, 
+                          void* context = nullptr):
+                                states(table),
+                                userContext(context),
+                                timer(Forever),
+                                stateCount(count),
+                                currentState(0),
+                                stateFlags(location == TIMED_STATE_TABLE_PROGMEM ? (1 << ProgmemFlagBit) : 0)
+                                {};
+
+        /**
+         * @brief Starts the machine by entering a state
+         * 
+         * @param initial The first state - defaults to 0
+         */
+        void begin(uint8_t initial = 0)
+        {
+            bitSet(stateFlags, StartFlagBit);
+            enter(initial, timer.now());
+        }
+
+        /**
+         * @brief Stops the machine in its current state.  No more 
+         *        timeouts are taken until begin() or transition().
+         */
+        void end() { bitClear(stateFlags, StartFlagBit); };
+
+        /**
+         * @brief Run the machine.  This function should be called from the
+         *        main loop.
+         * 
+         * @return bool True if the state changed
+         */
+        bool run() { return run(timer.now()); };
+
+        /**
+         * @brief Run the machine against a timestamp taken earlier with 
+         *        BasicTimer::now().
+         * 
+         * @param current The timestamp to run against
+         * @return bool True if the state changed
+         * @see TimerGroup
+         */
+        bool run(BasicTimer::TickType current)
+        {
+            if (!isRunning() || !timer.hasExpired(current)) return false;
+            TimedState row;
+            load(currentState, row);
+            enter(row.next, current);
+            return true;
+        }
+
+        /**
+         * @brief Enters a state now, whatever the current state's timeout.
+         *        Also starts a stopped machine.
+         * 
+         * @param state The state to enter
+         */
+        void transition(uint8_t state)
+        {
+            bitSet(stateFlags, StartFlagBit);
+            enter(state, timer.now());
+        }
+
+        /**
+         * @brief The current state
+         * 
+         * @return uint8_t 
+         */
+        uint8_t state() const { return currentState; };
+
+        /**
+         * @brief Gets if the machine has been started
+         * 
+         * @return bool
+         */
+        bool isRunning() const { return stateFlags & (1 << StartFlagBit); };
+
+        /**
+         * @brief The time in milliseconds since the current state was entered
+         * 
+         * @return unsigned long 
+         */
+        unsigned long timeInState() const { return timer.elapsedTime(); };
+
+        /**
+         * @brief The time until the current state times out, measured from 
+         *        a timestamp taken earlier with BasicTimer::now().
+         * 
+         * @param current The timestamp to measure from
+         * @return unsigned long The remaining time in milliseconds, or 
+         *         BasicTimer::NoDeadline if the machine is stopped or the 
+         *         state waits forever
+         */
+        unsigned long timeRemaining(BasicTimer::TickType current) const
+        {
+            if (!isRunning() || timer.timeout() == Forever) return BasicTimer::NoDeadline;
+            return timer.timeRemaining(current);
+        }
+
+        /**
+         * @brief The context pointer given to the constructor or setContext()
+         * 
+         * @return void* 
+         */
+        void* context() const { return userContext; };
+
+        /**
+         * @brief Sets the context pointer for the entry actions
+         * 
+         * @param context The new context pointer
+         */
+        void setContext(void* context) { userContext = context; };
+
+    protected:
+        /**
+         * @brief Bit position in stateFlags for a table in PROGMEM
+         */
+        static constexpr uint8_t ProgmemFlagBit = 0;
+
+        /**
+         * @brief Bit position in stateFlags for the start flag
+         */
+        static constexpr uint8_t StartFlagBit = 6;
+
+        const TimedState* states;
+        void* userContext;
+        BasicTimer timer;
+        uint8_t stateCount;
+        uint8_t currentState;
+        uint8_t stateFlags;
+
+        /**
+         * @brief Copies a row of the table into RAM
+         */
+        void load(uint8_t state, TimedState& row) const
+        {
+            if (stateFlags & (1 << ProgmemFlagBit)) {
+                memcpy_P(&row, &states[state], sizeof(TimedState));
+            } else {
+                row = states[state];
+            }
+        }
+
+        void enter(uint8_t state, BasicTimer::TickType current)
+        {
+            if (state >= stateCount) {
+                end();
+                return;
+            }
+            TimedState row;
+            load(state, row);
+            currentState = state;
+            timer.setTimeout(row.timeout);
+            timer.reset(current);
+            if (row.onEnter != nullptr) {
+                row.onEnter(*this);
+            }
+        }
+};
+
+#endif /* _BASIC_TIMER_TIMED_STATE_MACHINE_H_ */
@@ -0,0 +1,483 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerBank.h
+//!  @brief TimerBank class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_TIMER_BANK_H_
+#define _BASIC_TIMER_TIMER_BANK_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief Table of single bit masks used by the TimerBank scan
+ */
+template <typename Word>
+struct TimerBankBits
+{
+    static const Word Bit[32];
+};
+
+template <typename Word>
+const Word TimerBankBits<Word>::Bit[32] = {
+    Word(1) << 0,  Word(1) << 1,  Word(1) << 2,  Word(1) << 3,  Word(1) << 4,  Word(1) << 5,  Word(1) << 6,  Word(1) << 7,
+    Word(1) << 8,  Word(1) << 9,  Word(1) << 10, Word(1) << 11, Word(1) << 12, Word(1) << 13, Word(1) << 14, Word(1) << 15,
+    Word(1) << 16, Word(1) << 17, Word(1) << 18, Word(1) << 19, Word(1) << 20, Word(1) << 21, Word(1) << 22, Word(1) << 23,
+    Word(1) << 24, Word(1) << 25, Word(1) << 26, Word(1) << 27, Word(1) << 28, Word(1) << 29, Word(1) << 30, Word(1) << 31
+};
+
+/**
+ * @brief A fixed set of timers stored as parallel arrays, checked together
+ *        in a single scan.
+ * 
+ *    An array of CallbackTimers interleaves each timer's timestamp, timeout,
+ *    flags and callback pointer, so checking them all walks memory that is 
+ *    mostly not needed.  A TimerBank keeps every reset timestamp in one 
+ *    array and every timeout in another, with the state flags of a 
+ *    CallbackTimer (started, expired and run mode) held as bitsets of one 
+ *    bit per slot.  run() compares each block of 32 slots in a loop with no 
+ *    branches, which GCC and Clang turn into SIMD code on x86 and ARM hosts
+ *    at -O2 and above, and returns a bitmask of the slots that expired.
+ * 
+ *    Slots are numbered 0 to N - 1 and behave like a CallbackTimer without
+ *    a callback: TIMER_RUN_MODE_ONE_SHOT expires once until reset, 
+ *    TIMER_RUN_MODE_CONTINUOUS resets to the scan time, and both periodic 
+ *    modes advance by whole periods.
+ * 
+ * @tparam N The number of timer slots
+ * @tparam Clock The clock policy used for timestamps
+ */
+template <uint16_t N, typename Clock = MillisClock>
+class TimerBank
+{
+    public:
+        /**
+         * @brief The timestamp type of the clock policy
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief One word of a slot bitmask.  Bit j of word w is slot 32 * w + j.
+         */
+        typedef uint32_t MaskWord;
+
+        /**
+         * @brief The number of MaskWords in a slot bitmask
+         */
+        static constexpr uint16_t MaskWords = (N + 31) / 32;
+
+        /**
+         * @brief Returned by timeRemaining() when a slot will not expire
+         */
+        static constexpr TickType NoDeadline = static_cast<TickType>(~TickType(0));
+
+        /**
+         * @brief Construct a new TimerBank with every slot stopped
+         */
+        TimerBank()
+        {
+            for (uint16_t i = 0; i < N; i++) {
+                lastReset[i] = 0;
+                timeouts[i] = 0;
+            }
+            for (uint16_t w = 0; w < MaskWords; w++) {
+                enabledBits[w] = 0;
+                expiredBits[w] = 0;
+                modeLowBits[w] = 0;
+                modeHighBits[w] = 0;
+                dueBits[w] = 0;
+            }
+        };
+
+        /**
+         * @brief The number of slots in the bank
+         */
+        static constexpr uint16_t size() { return N; };
+
+        /**
+         * @brief Get the current time from the bank's clock
+         */
+        static TickType now() { return Clock::now(); };
+
+        /**
+         * @brief Sets the timeout and mode of a slot and starts it
+         * 
+         * @param slot The slot number, less than N
+         * @param timeout The timeout in clock ticks
+         * @param mode The timer mode - defaults to TIMER_RUN_MODE_ONE_SHOT
+         */
+        void begin(uint16_t slot, TickType timeout, TimerRunMode mode = TIMER_RUN_MODE_ONE_SHOT)
+        {
+            begin(slot, timeout, mode, now());
+        }
+
+        /**
+         * @brief Sets the timeout and mode of a slot and starts it from a 
+         *        timestamp taken earlier with now()
+         * 
+         * @param slot The slot number, less than N
+         * @param timeout The timeout in clock ticks
+         * @param mode The timer mode
+         * @param current The timestamp to start from
+         */
+        void begin(uint16_t slot, TickType timeout, TimerRunMode mode, TickType current)
+        {
+            timeouts[slot] = timeout;
+            setMode(slot, mode);
+            start(slot, current);
+        }
+
+        /**
+         * @brief Starts or restarts a slot
+         * 
+         * @param slot The slot number, less than N
+         */
+        void start(uint16_t slot) { start(slot, now()); };
+
+        /**
+         * @brief Starts or restarts a slot from a timestamp taken earlier 
+         *        with now()
+         * 
+         * @param slot The slot number, less than N
+         * @param current The timestamp to start from
+         */
+        void start(uint16_t slot, TickType current)
+        {
+            reset(slot, current);
+            setBit(enabledBits, slot);
+        }
+
+        /**
+         * @brief Stops/disables a slot
+         * 
+         * @param slot The slot number, less than N
+         */
+        void stop(uint16_t slot) { clearBit(enabledBits, slot); };
+
+        /**
+         * @brief Resets a slot so that its timeout period starts again
+         * 
+         * @param slot The slot number, less than N
+         */
+        void reset(uint16_t slot) { reset(slot, now()); };
+
+        /**
+         * @brief Resets a slot to a timestamp taken earlier with now()
+         * 
+         * @param slot The slot number, less than N
+         * @param current The timestamp to reset to
+         */
+        void reset(uint16_t slot, TickType current)
+        {
+            lastReset[slot] = current;
+            clearBit(expiredBits, slot);
+        }
+
+        /**
+         * @brief Set a slot's timeout.  Takes effect from the last reset.
+         * 
+         * @param slot The slot number, less than N
+         * @param timeout The timeout in clock ticks
+         */
+        void setTimeout(uint16_t slot, TickType timeout) { timeouts[slot] = timeout; };
+
+        /**
+         * @brief Get a slot's timeout in clock ticks
+         * 
+         * @param slot The slot number, less than N
+         */
+        TickType getTimeout(uint16_t slot) const { return timeouts[slot]; };
+
+        /**
+         * @brief Sets a slot's run mode
+         * 
+         * @param slot The slot number, less than N
+         * @param mode The TimerRunMode
+         */
+        void setMode(uint16_t slot, TimerRunMode mode)
+        {
+            writeBit(modeLowBits, slot, mode & 0x1);
+            writeBit(modeHighBits, slot, mode & 0x2);
+        }
+
+        /**
+         * @brief Gets a slot's run mode
+         * 
+         * @param slot The slot number, less than N
+         * @return TimerRunMode 
+         */
+        TimerRunMode mode(uint16_t slot) const
+        {
+            return static_cast<TimerRunMode>(readBit(modeLowBits, slot) | (readBit(modeHighBits, slot) << 1));
+        }
+
+        /**
+         * @brief Gets if a slot has been started
+         * 
+         * @param slot The slot number, less than N
+         */
+        bool hasStarted(uint16_t slot) const { return readBit(enabledBits, slot); };
+
+        /**
+         * @brief Gets if a one shot slot has expired and not been reset since
+         * 
+         * @param slot The slot number, less than N
+         */
+        bool hasPreviouslyExpired(uint16_t slot) const { return readBit(expiredBits, slot); };
+
+        /**
+         * @brief Checks every slot against the clock.  Should be called 
+         *        from the main loop.
+         * 
+         * @return const MaskWord* The MaskWords bitmask of slots that 
+         *         expired in this scan
+         * @see run(TickType)
+         */
+        const MaskWord* run() { return run(now()); };
+
+        /**
+         * @brief Checks every slot against a timestamp taken earlier with 
+         *        now(), resetting or advancing continuous and periodic 
+         *        slots that expired.
+         * 
+         * @param current The timestamp to check against
+         * @return const MaskWord* The MaskWords bitmask of slots that 
+         *         expired in this scan, valid until the next run()
+         */
+        const MaskWord* run(TickType current)
+        {
+            uint16_t w = 0;
+            for (; w < N / 32; w++) {
+                settle(w, expiredBlock(w * 32, current), current);
+            }
+            if (N % 32) {
+                settle(w, expiredTail(w * 32, N % 32, current), current);
+            }
+            return dueBits;
+        }
+
+        /**
+         * @brief Gets if a slot expired in the last run()
+         * 
+         * @param slot The slot number, less than N
+         */
+        bool isDue(uint16_t slot) const { return readBit(dueBits, slot); };
+
+        /**
+         * @brief The time until a slot next expires, measured from a 
+         *        timestamp taken earlier with now().
+         * 
+         * @param slot The slot number, less than N
+         * @param current The timestamp to measure from
+         * @return TickType The remaining time in clock ticks, or 
+         *         NoDeadline if the slot is stopped or a one 
+         *         shot slot has already expired
+         */
+        TickType timeRemaining(uint16_t slot, TickType current) const
+        {
+            if (!hasStarted(slot) || hasPreviouslyExpired(slot)) return NoDeadline;
+            TickType elapsed = elapsedAt(slot, current);
+            if (elapsed > timeouts[slot]) return 0;
+            return static_cast<TickType>(timeouts[slot] - elapsed + 1);
+        }
+
+    protected:
+        TickType lastReset[N];
+        TickType timeouts[N];
+        MaskWord enabledBits[MaskWords];
+        MaskWord expiredBits[MaskWords];
+        MaskWord modeLowBits[MaskWords];
+        MaskWord modeHighBits[MaskWords];
+        MaskWord dueBits[MaskWords];
+
+        /**
+         * @brief The time since a slot was reset.  A slot reset after 
+         *        current, which happens when a timestamp is taken before 
+         *        another slot's handling restarts it, wraps to an elapsed 
+         *        time over half the range past its timeout and counts as 
+         *        just started, by the same rule as TBasicTimer.
+         */
+        TickType elapsedAt(uint16_t slot, TickType current) const
+        {
+            TickType elapsed = static_cast<TickType>(current - lastReset[slot]);
+            if (elapsed > timeouts[slot] + (NoDeadline - timeouts[slot]) / 2) return 0;
+            return elapsed;
+        }
+
+        /**
+         * @brief Compares the 32 slots starting at first against current.
+         * 
+         *        The loop has a fixed trip count and no branches, and picks
+         *        each slot's bit from a table rather than shifting by the 
+         *        loop counter, which is what lets GCC and Clang vectorize it.
+         *        The elapsedAt() rule is folded into a single compare: 
+         *        late wraps to at least NoDeadline - timeout while the slot 
+         *        has not expired.
+         * 
+         * @return MaskWord Bit j set if slot first + j has passed its timeout
+         */
+        MaskWord expiredBlock(uint16_t first, TickType current) const
+        {
+            const TickType* resets = lastReset + first;
+            const TickType* limits = timeouts + first;
+            MaskWord hits = 0;
+            for (uint8_t j = 0; j < 32; j++) {
+                TickType late = static_cast<TickType>(current - resets[j] - limits[j] - 1);
+                TickType window = static_cast<TickType>((NoDeadline - limits[j]) / 2);
+                hits |= (late < window) ? slotBit(j) : 0;
+            }
+            return hits;
+        }
+
+        /**
+         * @brief Compares the last count (less than 32) slots starting at 
+         *        first against current.
+         * 
+         * @return MaskWord Bit j set if slot first + j has passed its timeout
+         */
+        MaskWord expiredTail(uint16_t first, uint8_t count, TickType current) const
+        {
+            MaskWord hits = 0;
+            for (uint8_t j = 0; j < count; j++) {
+                if (elapsedAt(first + j, current) > timeouts[first + j]) hits |= static_cast<MaskWord>(1) << j;
+            }
+            return hits;
+        }
+
+        /**
+         * @brief The mask for bit j of a MaskWord.  A 128 byte table is 
+         *        not worth the RAM on AVR, which has no vector unit.
+         */
+        static MaskWord slotBit(uint8_t j)
+        {
+#if defined(__AVR__)
+            return static_cast<MaskWord>(1) << j;
+#else
+            return TimerBankBits<MaskWord>::Bit[j];
+#endif
+        }
+
+        /**
+         * @brief Records the slots of word w that expired and restarts the 
+         *        continuous and periodic ones
+         */
+        void settle(uint16_t w, MaskWord hits, TickType current)
+        {
+            hits &= enabledBits[w] & ~expiredBits[w];
+            dueBits[w] = hits;
+            while (hits) {
+                uint8_t j = static_cast<uint8_t>(__builtin_ctzl(hits));
+                hits &= hits - 1;
+                uint16_t slot = w * 32 + j;
+                MaskWord bit = static_cast<MaskWord>(1) << j;
+                if (modeHighBits[w] & bit) {
+                    advance(slot, current);
+                } else if (modeLowBits[w] & bit) {
+                    lastReset[slot] = current;
+                } else {
+                    expiredBits[w] |= bit;
+                }
+            }
+        }
+
+        /**
+         * @brief Moves a periodic slot forward by whole periods, keeping 
+         *        its phase.  Matches BasicTimer::advance().
+         */
+        void advance(uint16_t slot, TickType current)
+        {
+            TickType timeout = timeouts[slot];
+            if (timeout == 0) {
+                lastReset[slot] = current;
+                return;
+            }
+            TickType elapsed = elapsedAt(slot, current);
+            TickType periods = static_cast<TickType>((elapsed - 1) / timeout);
+            lastReset[slot] = static_cast<TickType>(lastReset[slot] + periods * timeout);
+        }
+
+        static bool readBit(const MaskWord* bits, uint16_t slot)
+        {
+            return (bits[slot / 32] >> (slot % 32)) & 1;
+        }
+
+        static void setBit(MaskWord* bits, uint16_t slot)
+        {
+            bits[slot / 32] |= static_cast<MaskWord>(1) << (slot % 32);
+        }
+
+        static void clearBit(MaskWord* bits, uint16_t slot)
+        {
+            bits[slot / 32] &= ~(static_cast<MaskWord>(1) << (slot % 32));
+        }
+
+        static void writeBit(MaskWord* bits, uint16_t slot, bool value)
+        {
+            if (value) {
+                setBit(bits, slot);
+            } else {
+                clearBit(bits, slot);
+            }
+        }
+};
+
+template <uint16_t N, typename Clock>
+constexpr uint16_t TimerBank<N, Clock>::MaskWords;
+
+template <uint16_t N, typename Clock>
+constexpr typename TimerBank<N, Clock>::TickType TimerBank<N, Clock>::NoDeadline;
+
+#endif /* _BASIC_TIMER_TIMER_BANK_H_ */
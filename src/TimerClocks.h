@@ -0,0 +1,218 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerClocks.h
+//!  @brief Clock source policies for the timer classes
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+#ifndef _BASIC_TIMER_TIMER_CLOCKS_H_
+#define _BASIC_TIMER_TIMER_CLOCKS_H_
+
+#include <Arduino.h>
+
+/*
+ *  A clock policy tells the timer templates (TBasicTimer, TStaticTimer) 
+ *  where time comes from.  Any type with the following members can be used:
+ * 
+ *      struct MyClock
+ *      {
+ *          typedef uint16_t TickType;                          // timestamp type, must be unsigned
+ *          static TickType now() { return TCNT1; }             // read the current time
+ *          static constexpr unsigned long TicksPerSecond = 250000;  // tick rate
+ *      };
+ * 
+ *  Timestamps are compared with unsigned subtraction, so the counter must
+ *  wrap around at the full range of TickType.
+ */
+
+/**
+ * @brief Clock policy backed by millis().  The default for every timer.
+ */
+struct MillisClock
+{
+    /**
+     * @brief millis() is a 32 bit counter
+     */
+    typedef uint32_t TickType;
+
+    /**
+     * @brief Get the current time in milliseconds
+     */
+    static TickType now() { return millis(); }
+
+    /**
+     * @brief Clock rate in ticks per second
+     */
+    static constexpr unsigned long TicksPerSecond = 1000UL;
+};
+
+/**
+ * @brief Clock policy backed by micros().  Wraps around after ~71 minutes.
+ */
+struct MicrosClock
+{
+    /**
+     * @brief micros() is a 32 bit counter
+     */
+    typedef uint32_t TickType;
+
+    /**
+     * @brief Get the current time in microseconds
+     */
+    static TickType now() { return micros(); }
+
+    /**
+     * @brief Clock rate in ticks per second
+     */
+    static constexpr unsigned long TicksPerSecond = 1000000UL;
+};
+
+/**
+ * @brief Clock policy that keeps only the low bits of another clock, 
+ *        optionally after dividing it by a power of two.
+ * 
+ *    Timers using a CompactClock store 8 or 16 bit timestamps instead of 
+ *    32 bit ones.  The price is range: a timer must be checked before 
+ *    2^bits ticks pass or it will wrap around and look unexpired again.
+ * 
+ *    For example CompactClock<uint8_t, 4> counts in 16 ms steps and wraps 
+ *    after ~4 seconds, which is plenty for switch debouncing.
+ * 
+ * @tparam T The unsigned timestamp type (uint8_t or uint16_t)
+ * @tparam SHIFT Each tick is 2^SHIFT ticks of the underlying clock
+ * @tparam Clock The underlying clock policy
+ */
+template <typename T, uint8_t SHIFT = 0, typename Clock = MillisClock>
+struct CompactClock
+{
+    static_assert(static_cast<T>(-1) > 0, "CompactClock tick type must be unsigned");
+    static_assert(sizeof(T) <= sizeof(typename Clock::TickType), "CompactClock tick type must not be wider than the underlying clock");
+
+    /**
+     * @brief The compact timestamp type
+     */
+    typedef T TickType;
+
+    /**
+     * @brief Get the current time in compact ticks
+     */
+    static TickType now() { return static_cast<TickType>(Clock::now() >> SHIFT); }
+
+    /**
+     * @brief Clock rate in ticks per second (rounded down)
+     */
+    static constexpr unsigned long TicksPerSecond = Clock::TicksPerSecond >> SHIFT;
+};
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+/**
+ * @brief Clock policy backed by the CPU cycle counter.  Wraps around after
+ *        2^32 cycles (~18 seconds at 240MHz).
+ */
+struct CycleCounterClock
+{
+    typedef uint32_t TickType;
+
+    /**
+     * @brief Nothing to do, the counter always runs on these cores
+     */
+    static void begin() {}
+
+    /**
+     * @brief Get the current time in CPU cycles
+     */
+    static TickType now() { return ESP.getCycleCount(); }
+
+    /**
+     * @brief Clock rate in ticks per second
+     */
+    static constexpr unsigned long TicksPerSecond = F_CPU;
+};
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+/**
+ * @brief Clock policy backed by the Cortex-M DWT cycle counter.  
+ *        CycleCounterClock::begin() must be called once before use.
+ */
+struct CycleCounterClock
+{
+    typedef uint32_t TickType;
+
+    /**
+     * @brief Enables the DWT cycle counter
+     */
+    static void begin()
+    {
+        demcr() |= (1UL << 24);     // TRCENA
+        dwtCycleCount() = 0;
+        dwtControl() |= 1UL;        // CYCCNTENA
+    }
+
+    /**
+     * @brief Get the current time in CPU cycles
+     */
+    static TickType now() { return dwtCycleCount(); }
+
+    /**
+     * @brief Clock rate in ticks per second
+     */
+    static constexpr unsigned long TicksPerSecond = F_CPU;
+
+    private:
+        static volatile uint32_t& demcr() { return *reinterpret_cast<volatile uint32_t*>(0xE000EDFCUL); }
+        static volatile uint32_t& dwtControl() { return *reinterpret_cast<volatile uint32_t*>(0xE0001000UL); }
+        static volatile uint32_t& dwtCycleCount() { return *reinterpret_cast<volatile uint32_t*>(0xE0001004UL); }
+};
+#endif
+
+#endif /* _BASIC_TIMER_TIMER_CLOCKS_H_ */
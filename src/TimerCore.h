@@ -0,0 +1,615 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerCore.h
+//!  @brief BasicTimer and StaticTimer class definitions
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#ifndef _BASIC_TIMER_TIMER_CORE_H_
+#define _BASIC_TIMER_TIMER_CORE_H_
+
+#include <Arduino.h>
+#include "./TimerClocks.h"
+
+/**
+ * @brief How a repeating timer behaves when it expires.
+ * 
+ *   TIMER_RUN_MODE_ONE_SHOT expires once and stays expired.
+ * 
+ *   TIMER_RUN_MODE_CONTINUOUS restarts from the time the expiry was seen, 
+ *   so any lateness in the loop is added to the period.
+ * 
+ *   TIMER_RUN_MODE_PERIODIC moves the deadline forward by exactly one 
+ *   period each time, keeping the original phase.  If whole periods were 
+ *   missed because the loop stalled, it skips to the latest one and fires 
+ *   once.
+ * 
+ *   TIMER_RUN_MODE_PERIODIC_CATCH_UP is the same as TIMER_RUN_MODE_PERIODIC,
+ *   but fires once for every period that ended, including missed ones.
+ */
+enum TimerRunMode: uint8_t {
+    TIMER_RUN_MODE_ONE_SHOT = 0,
+    TIMER_RUN_MODE_CONTINUOUS = 1,
+    TIMER_RUN_MODE_PERIODIC = 2,
+    TIMER_RUN_MODE_PERIODIC_CATCH_UP = 3
+};
+
+/**
+ * @brief Class template that wraps clock based timers for easier use.
+ * 
+ *  A TBasicTimer makes it easy to perform an action after a certain amount of clock ticks has passed.
+ *  All times are in ticks of the Clock policy, which are milliseconds for BasicTimer.
+ * 
+ * @tparam Clock The clock policy that supplies the time
+ * @see TimerClocks.h
+ */
+template <typename Clock>
+class TBasicTimer
+{
+    public:
+        /**
+         * @brief The clock's timestamp type
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief Value returned by deadline queries when nothing 
+         *        is pending.
+         */
+        static constexpr TickType NoDeadline = static_cast<TickType>(~TickType(0));
+
+        /**
+         * @brief Timeout used when none is given: 500 ticks, or half the
+         *        tick range for tick types too narrow to hold 500.
+         */
+        static constexpr TickType DefaultTimeout = (500UL < NoDeadline / 2) ? 
+            static_cast<TickType>(500) : static_cast<TickType>(NoDeadline / 2);
+
+        /**
+         * @brief Construct a new TBasicTimer 
+         * 
+         * @param timeout The timers timeout in clock ticks
+         */
+        TBasicTimer(TickType timeout = DefaultTimeout):  lastReset(0), storedTimeout(timeout){};
+
+        /**
+         * @brief Copy Constructor
+         */
+        TBasicTimer(const TBasicTimer& other): lastReset(other.lastReset),
+            storedTimeout(other.storedTimeout){};
+
+
+        /**
+         *  @brief Prepares the timer for use, equivalent to reset()
+         *  @see reset()
+         */
+        void begin(){ reset(); };
+
+        /**
+         *  @brief Prepares the timer for use and sets the timeout to the 
+         *         supplied value
+         * 
+         *  @see reset()
+         *  @see setTimeout()
+         */
+        void begin(TickType timeout) { 
+            setTimeout(timeout);
+            reset(); 
+        };
+
+        /**
+         * @brief Resets the timer (so that it is no longer expired)
+         */
+        void reset(){  lastReset = now(); };
+
+        /**
+         * @brief Resets the timer to a timestamp taken earlier with now()
+         * 
+         * @param current The timestamp to reset to
+         */
+        void reset(TickType current){  lastReset = current; };
+
+        /**
+         * @brief Check if the timer has expired
+         * 
+         * @return true If the timer has expired
+         * @return false If it has yet to expire
+         */
+        bool hasExpired() const
+        {
+            if (elapsedTime() > storedTimeout) return true;
+            else return false;
+        }
+
+        /**
+         * @brief Returns the timer's stored timeout time in clock ticks
+         * 
+         * @return TickType 
+         */
+        TickType timeout() const { return storedTimeout; };
+        
+        /**
+         * @brief Get the current time in clock ticks
+         * 
+         * @return TickType The current time in clock ticks
+         */
+        static TickType now()
+        {
+            return Clock::now();
+        }
+
+        /**
+         * @brief The amount of time that has elapsed since the timer
+         *        was last reset in clock ticks.
+         * 
+         * @return TickType The elapsed time in clock ticks
+         */
+        TickType elapsedTime() const {
+            return static_cast<TickType>(now() - lastReset);
+        }
+
+        /**
+         * @brief The amount of time left until the timer expires 
+         *        in clock ticks.
+         * 
+         *        This is the time until hasExpired() will return true, 
+         *        or 0 if it already has.
+         * 
+         * @return TickType The remaining time in clock ticks
+         */
+        TickType timeRemaining() const {
+            TickType elapsed = elapsedTime();
+            if (elapsed > storedTimeout) return 0;
+            else return static_cast<TickType>(storedTimeout - elapsed + 1);
+        }
+
+        /**
+         * @brief Check if the timer had expired at a timestamp taken 
+         *        earlier with now().
+         * 
+         *        Checking many timers against one timestamp saves clock 
+         *        reads and makes timers with the same deadline agree.
+         * 
+         * @param current The timestamp to check against
+         * @see elapsedTime(TickType)
+         */
+        bool hasExpired(TickType current) const
+        {
+            return elapsedTime(current) > storedTimeout;
+        }
+
+        /**
+         * @brief The time elapsed between the last reset and a timestamp 
+         *        taken earlier with now().
+         * 
+         *        A timer reset after the timestamp was taken (by a callback,
+         *        for example) counts as just reset.  To tell the two apart,
+         *        an expired timer must be checked within half of the clock
+         *        range left over after its timeout (~24 days for millis()).
+         * 
+         * @param current The timestamp to measure to
+         * @return TickType The elapsed time in clock ticks
+         */
+        TickType elapsedTime(TickType current) const {
+            TickType elapsed = static_cast<TickType>(current - lastReset);
+            if (elapsed > storedTimeout + (NoDeadline - storedTimeout) / 2) return 0;
+            else return elapsed;
+        }
+
+        /**
+         * @brief The time left until the timer expires, measured from a 
+         *        timestamp taken earlier with now().
+         * 
+         * @param current The timestamp to measure from
+         * @return TickType The remaining time in clock ticks
+         */
+        TickType timeRemaining(TickType current) const {
+            TickType elapsed = elapsedTime(current);
+            if (elapsed > storedTimeout) return 0;
+            else return static_cast<TickType>(storedTimeout - elapsed + 1);
+        }
+
+        /**
+         * @brief Moves the timer forward by whole timeout periods so that 
+         *        it is no longer expired, keeping its original phase.
+         * 
+         *        Unlike reset(), lateness in noticing the expiry is not 
+         *        added to the next period, so a timer advanced every time 
+         *        it expires does not drift.
+         * 
+         * @param current The timestamp to advance to
+         * @return TickType The number of periods that had ended 
+         *         (0 if the timer had not expired)
+         */
+        TickType advance(TickType current)
+        {
+            TickType elapsed = elapsedTime(current);
+            if (elapsed <= storedTimeout) return 0;
+            if (storedTimeout == 0) {
+                lastReset = current;
+                return 1;
+            }
+            TickType periods = static_cast<TickType>((elapsed - 1) / storedTimeout);
+            lastReset = static_cast<TickType>(lastReset + periods * storedTimeout);
+            return periods;
+        }
+
+        /**
+         * @brief Moves the timer forward by whole timeout periods so that 
+         *        it is no longer expired, keeping its original phase.
+         * 
+         * @return TickType The number of periods that had ended
+         * @see advance(TickType)
+         */
+        TickType advance() { return advance(now()); };
+
+        /**
+         * @brief Set the timer's timeout to the supplied value
+         * 
+         * @param timeout The new timer period in clock ticks
+         */
+        void setTimeout(TickType timeout){ storedTimeout = timeout; };
+
+        /**
+         * @brief Runs the timer, executing the supplied function after each timeout
+         * 
+         * @param callback The function to execute when the timer expires
+         * @param resetOnExpire If true, the timer will reset every time 
+         *                      (executing callback after every timeout period)
+         */
+        void whenExpired(void(*callback)(), bool resetOnExpire = false)
+        {
+            if(hasExpired())
+            {
+                reset();
+                callback();
+            }
+        }
+
+        /**
+         * @brief Runs the timer, executing the supplied function after each timeout
+         * 
+         * @tparam ArgumentType Type of argument for the callback 
+         *          (for template deduction)
+         * @param callback  The function to execute when the timer expires
+         * @param callbackArg Argument that will be supplied to the 
+         *                    function when it expires
+         */
+        template<typename ArgumentType>
+        void whenExpired(void(*callback)(ArgumentType arg), 
+                         ArgumentType callbackArg)
+        {
+            if(hasExpired())
+            {
+                reset();
+                callback(callbackArg);
+            }
+        }
+    protected:
+        TickType  lastReset; //!< The last timestamp at which the timer was reset
+        TickType storedTimeout;//!< The timeout value in clock ticks
+};
+
+template <typename Clock>
+constexpr typename TBasicTimer<Clock>::TickType TBasicTimer<Clock>::NoDeadline;
+
+template <typename Clock>
+constexpr typename TBasicTimer<Clock>::TickType TBasicTimer<Clock>::DefaultTimeout;
+
+/**
+ * @brief A millis() based TBasicTimer, all times are in milliseconds
+ */
+typedef TBasicTimer<MillisClock> BasicTimer;
+
+/**
+ * @brief Template class for a timer with a static, constant Timeout value.
+ *        This reduces the memory footprint of the class if you never want the
+ *        timers time to change.
+ * 
+ * @tparam TIMEOUT The timeout in clock ticks
+ * @tparam Clock The clock policy that supplies the time
+ */
+template <unsigned long TIMEOUT, typename Clock>
+class TStaticTimer
+{
+    public:
+        /**
+         * @brief The clock's timestamp type
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief Largest value of TickType
+         */
+        static constexpr TickType NoDeadline = static_cast<TickType>(~TickType(0));
+
+        static_assert(static_cast<unsigned long long>(TIMEOUT) < static_cast<unsigned long long>(NoDeadline), 
+                      "TIMEOUT is too large for the clock's tick type");
+
+        /**
+         * @brief onExpire callback handler type
+         */
+        typedef void(*OnExpireFunction)();
+
+        /**
+         * @brief Construct a new TStaticTimer object
+         * 
+         */
+        TStaticTimer():  lastReset(0){};
+
+        /**
+         * @brief Reset the timer, setting its value to the current time
+         * 
+         */
+        void reset(){  lastReset = now(); };
+
+        /**
+         * @brief Resets the timer to a timestamp taken earlier with now()
+         * 
+         * @param current The timestamp to reset to
+         */
+        void reset(TickType current){  lastReset = current; };
+
+        /**
+         * @brief Checks it the timer has expired
+         * 
+         * @return true If the timeout has passed
+         * @return false If not.
+         */
+        bool hasExpired() const
+        {
+            if (elapsedTime() > TIMEOUT) return true;
+            else return false;
+        }
+
+        /**
+         * @brief Gets the currenet timestamp in clock ticks
+         * 
+         * @return TickType The current timestamp in clock ticks
+         */
+        static TickType now()
+        {
+            return Clock::now();
+        }
+
+        /**
+         * @brief The amount of time that has elapsed since the timer
+         *        was last reset in clock ticks.
+         * 
+         * @return TickType The elapsed time in clock ticks
+         */
+        TickType elapsedTime() const {
+            return static_cast<TickType>(now() - lastReset);
+        }
+
+        /**
+         * @brief The amount of time left until the timer expires 
+         *        in clock ticks.
+         * 
+         *        This is the time until hasExpired() will return true, 
+         *        or 0 if it already has.
+         * 
+         * @return TickType The remaining time in clock ticks
+         */
+        TickType timeRemaining() const {
+            TickType elapsed = elapsedTime();
+            if (elapsed > TIMEOUT) return 0;
+            else return static_cast<TickType>(TIMEOUT - elapsed + 1);
+        }
+
+        /**
+         * @brief Check if the timer had expired at a timestamp taken 
+         *        earlier with now().
+         * 
+         *        Checking many timers against one timestamp saves clock 
+         *        reads and makes timers with the same deadline agree.
+         * 
+         * @param current The timestamp to check against
+         * @see elapsedTime(TickType)
+         */
+        bool hasExpired(TickType current) const
+        {
+            return elapsedTime(current) > TIMEOUT;
+        }
+
+        /**
+         * @brief The time elapsed between the last reset and a timestamp 
+         *        taken earlier with now().
+         * 
+         *        A timer reset after the timestamp was taken (by a callback,
+         *        for example) counts as just reset.  To tell the two apart,
+         *        an expired timer must be checked within half of the clock
+         *        range left over after its timeout (~24 days for millis()).
+         * 
+         * @param current The timestamp to measure to
+         * @return TickType The elapsed time in clock ticks
+         */
+        TickType elapsedTime(TickType current) const {
+            TickType elapsed = static_cast<TickType>(current - lastReset);
+            if (elapsed > TIMEOUT + (NoDeadline - TIMEOUT) / 2) return 0;
+            else return elapsed;
+        }
+
+        /**
+         * @brief The time left until the timer expires, measured from a 
+         *        timestamp taken earlier with now().
+         * 
+         * @param current The timestamp to measure from
+         * @return TickType The remaining time in clock ticks
+         */
+        TickType timeRemaining(TickType current) const {
+            TickType elapsed = elapsedTime(current);
+            if (elapsed > TIMEOUT) return 0;
+            else return static_cast<TickType>(TIMEOUT - elapsed + 1);
+        }
+
+        /**
+         * @brief Moves the timer forward by whole timeout periods so that 
+         *        it is no longer expired, keeping its original phase.
+         * 
+         *        Unlike reset(), lateness in noticing the expiry is not 
+         *        added to the next period, so a timer advanced every time 
+         *        it expires does not drift.
+         * 
+         * @param current The timestamp to advance to
+         * @return TickType The number of periods that had ended 
+         *         (0 if the timer had not expired)
+         */
+        TickType advance(TickType current)
+        {
+            TickType elapsed = elapsedTime(current);
+            if (elapsed <= TIMEOUT) return 0;
+            if (TIMEOUT == 0) {
+                lastReset = current;
+                return 1;
+            }
+            TickType periods = static_cast<TickType>((elapsed - 1) / TIMEOUT);
+            lastReset = static_cast<TickType>(lastReset + periods * TIMEOUT);
+            return periods;
+        }
+
+        /**
+         * @brief Moves the timer forward by whole timeout periods so that 
+         *        it is no longer expired, keeping its original phase.
+         * 
+         * @return TickType The number of periods that had ended
+         * @see advance(TickType)
+         */
+        TickType advance() { return advance(now()); };
+
+        /**
+         * @brief Runs the timer, executing the supplied function if the timer has expired.
+         * 
+         * @param callback The function to execute
+         * @param resetOnExpire If true, the timer will reset every time 
+         *                      (executing callback after every timeout period)
+         */
+        void whenExpired(OnExpireFunction callback, bool resetOnExpire = false)
+        {
+            if(hasExpired())
+            {
+                if (resetOnExpire) reset();
+                callback();
+            }
+        }
+
+        /**
+         * @brief Runs the timer, executing the supplied function if the timer has expired.
+         * 
+         * @param callback The function to execute
+         * @param resetOnExpire If true, the timer will reset every time 
+         *                      (executing callback after every timeout period)
+         */
+        template<typename CallbackArgumentType>
+        void whenExpired(OnExpireFunction callback, bool resetOnExpire = false)
+        {
+            if(hasExpired())
+            {
+                if (resetOnExpire) reset();
+                callback();
+            }
+        }
+
+
+
+    protected:
+        TickType  lastReset;
+};
+
+template <unsigned long TIMEOUT, typename Clock>
+constexpr typename TStaticTimer<TIMEOUT, Clock>::TickType TStaticTimer<TIMEOUT, Clock>::NoDeadline;
+
+/**
+ * @brief A millis() based TStaticTimer
+ * 
+ * @tparam TIMEOUT The timeout in milliseconds
+ */
+template <unsigned long TIMEOUT>
+using StaticTimer = TStaticTimer<TIMEOUT, MillisClock>;
+
+/**
+ * @brief A TBasicTimer that stores 8 or 16 bit timestamps to save RAM.
+ * 
+ *        A CompactTimer<uint16_t> takes 4 bytes instead of 8 and handles 
+ *        timeouts up to 65 seconds with hasExpired().  It must be checked 
+ *        at least once every 65 seconds, or the elapsed time wraps around.
+ * 
+ *        The timestamp overloads such as hasExpired(TickType) treat an 
+ *        elapsed time past the middle of the range left after the timeout
+ *        as a reset made after the timestamp, so with them keep timeouts 
+ *        under half the range (~32 seconds for uint16_t ticks) and check 
+ *        the timer well before it has been expired that long.
+ * 
+ *        The default timeout is 500 ticks, or 127 for uint8_t ticks.
+ * 
+ * @tparam T The timestamp type, uint8_t or uint16_t
+ * @tparam SHIFT Each tick is 2^SHIFT milliseconds
+ * @see CompactClock
+ */
+template <typename T, uint8_t SHIFT = 0>
+using CompactTimer = TBasicTimer<CompactClock<T, SHIFT>>;
+
+/**
+ * @brief A TStaticTimer that stores only an 8 or 16 bit timestamp.
+ * 
+ *        A timeout too large for the timestamp type fails to compile.
+ * 
+ * @tparam TIMEOUT The timeout in ticks of 2^SHIFT milliseconds
+ * @tparam T The timestamp type, uint8_t or uint16_t
+ * @tparam SHIFT Each tick is 2^SHIFT milliseconds
+ * @see CompactClock
+ */
+template <unsigned long TIMEOUT, typename T, uint8_t SHIFT = 0>
+using CompactStaticTimer = TStaticTimer<TIMEOUT, CompactClock<T, SHIFT>>;
+
+#endif /* _BASIC_TIMER_TIMER_CORE_H_ */
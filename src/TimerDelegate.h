@@ -0,0 +1,225 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerDelegate.h
+//!  @brief TimerDelegate class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_TIMER_DELEGATE_H_
+#define _BASIC_TIMER_TIMER_DELEGATE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+// AVR has no <type_traits>, and GCC before 5 lacks is_trivially_copyable
+#if defined(__AVR__) || (defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5)
+#define BASIC_TIMER_TRIVIALLY_COPYABLE(T) __has_trivial_copy(T)
+#else
+#include <type_traits>
+#define BASIC_TIMER_TRIVIALLY_COPYABLE(T) std::is_trivially_copyable<T>::value
+#endif
+
+/**
+ * @brief A fixed size callable that never allocates, for timer callbacks 
+ *        that need context.
+ * 
+ *    A TimerDelegate can hold any one of:
+ *      - a plain function, void f()
+ *      - a function taking a context pointer, void f(void*), and the pointer
+ *      - a member function bound to an object, with bind<Class, &Class::method>(&object)
+ *      - a lambda or other function object no larger than two pointers 
+ *        (for example [this] or [&counter, pin]), stored inline
+ * 
+ *    Function objects are copied as plain bytes and never destroyed, so 
+ *    their captures must be trivially copyable: pointers, references and 
+ *    integers, not Strings or other objects that own memory.  This is 
+ *    checked at compile time.
+ * 
+ *    Size: two pointers of storage plus one function pointer, which is 6 
+ *    bytes on AVR and 24 bytes on 64 bit hosts.
+ * 
+ *    Dispatch: one indirect call to a small stub chosen at construction.  
+ *    The stub calls the target directly, or through one more indirect call 
+ *    for the plain and context function forms.
+ */
+class TimerDelegate
+{
+    public:
+        /**
+         * @brief The number of bytes available for a function object
+         */
+        static constexpr uint8_t StorageSize = 2 * sizeof(void*);
+
+        /**
+         * @brief Construct an empty delegate
+         */
+        TimerDelegate(): invoker(nullptr) {};
+
+        /**
+         * @brief Construct an empty delegate from nullptr
+         */
+        TimerDelegate(decltype(nullptr)): invoker(nullptr) {};
+
+        /**
+         * @brief Construct a delegate that calls a plain function
+         * 
+         * @param function The function to call, or nullptr for none
+         */
+        TimerDelegate(void (*function)()): invoker(function ? &callFunction : nullptr)
+        {
+            storage.function = function;
+        };
+
+        /**
+         * @brief Construct a delegate that calls a function with a context 
+         *        pointer
+         * 
+         * @param function The function to call, or nullptr for none
+         * @param context The pointer to pass to function
+         */
+        TimerDelegate(void (*function)(void*), void* context): invoker(function ? &callWithContext : nullptr)
+        {
+            storage.withContext.function = function;
+            storage.withContext.context = context;
+        };
+
+        /**
+         * @brief Construct a delegate that calls a copy of a lambda or other
+         *        function object, stored inline.
+         * 
+         * @tparam Functor A trivially copyable type with void operator()(), 
+         *         no larger than StorageSize
+         * @param functor The function object to copy
+         */
+        template <typename Functor>
+        TimerDelegate(const Functor& functor): invoker(&callFunctor<Functor>)
+        {
+            static_assert(sizeof(Functor) <= StorageSize, "Function object is too large for a TimerDelegate");
+            static_assert(alignof(Functor) <= alignof(Storage), "Function object is over aligned for a TimerDelegate");
+            static_assert(BASIC_TIMER_TRIVIALLY_COPYABLE(Functor), "Function object must be trivially copyable for a TimerDelegate");
+            memcpy(storage.functor, &functor, sizeof(Functor));
+        };
+
+        /**
+         * @brief Construct a delegate that calls a member function on an object
+         * 
+         *        timer.onExpire(TimerDelegate::bind<Motor, &Motor::stop>(&motor));
+         * 
+         * @tparam T The object's class
+         * @tparam Method The member function to call, void T::method()
+         * @param object The object to call it on, which must outlive the delegate
+         */
+        template <typename T, void (T::*Method)()>
+        static TimerDelegate bind(T* object)
+        {
+            TimerDelegate delegate;
+            delegate.storage.object = object;
+            delegate.invoker = &callMethod<T, Method>;
+            return delegate;
+        }
+
+        /**
+         * @brief Calls the target.  The delegate must not be empty.
+         */
+        void operator()() { invoker(storage); };
+
+        /**
+         * @brief True if the delegate has a target
+         */
+        explicit operator bool() const { return invoker != nullptr; };
+
+        bool operator==(decltype(nullptr)) const { return invoker == nullptr; };
+        bool operator!=(decltype(nullptr)) const { return invoker != nullptr; };
+
+    protected:
+        /**
+         * @brief Inline storage shared by every kind of target
+         */
+        union Storage
+        {
+            void (*function)();
+            struct
+            {
+                void (*function)(void*);
+                void* context;
+            } withContext;
+            void* object;
+            unsigned char functor[StorageSize];
+        };
+
+        Storage storage;
+        void (*invoker)(Storage& storage);
+
+        static void callFunction(Storage& storage) { storage.function(); }
+
+        static void callWithContext(Storage& storage) 
+        { 
+            storage.withContext.function(storage.withContext.context); 
+        }
+
+        template <typename T, void (T::*Method)()>
+        static void callMethod(Storage& storage)
+        {
+            (static_cast<T*>(storage.object)->*Method)();
+        }
+
+        template <typename Functor>
+        static void callFunctor(Storage& storage)
+        {
+            (*reinterpret_cast<Functor*>(storage.functor))();
+        }
+};
+
+#endif /* _BASIC_TIMER_TIMER_DELEGATE_H_ */
@@ -0,0 +1,201 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerGroup.h
+//!  @brief TimerGroup class definitions
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+#ifndef _BASIC_TIMER_TIMER_GROUP_H_
+#define _BASIC_TIMER_TIMER_GROUP_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief Runs a set of timers, blinkers and queues against a single clock 
+ *        read per pass.
+ * 
+ *    Every hasExpired(), run() or reset() call on its own reads millis(), 
+ *    which on AVR means disabling interrupts and copying 4 bytes each time.
+ *    A TimerGroup reads the clock once in run() and evaluates every member
+ *    against that snapshot, so members with the same deadline always agree
+ *    on whether they have expired.
+ * 
+ *    Any object with a timeRemaining(current) member can be added, and 
+ *    objects that also have run(current), such as CallbackTimers, blinkers
+ *    and TimerQueues, are run by the group.  Plain BasicTimers and 
+ *    StaticTimers have no run(), so they only count towards timeUntilNext()
+ *    and are checked in loop() against the same snapshot with 
+ *    timer.hasExpired(group.now()).
+ * 
+ *    Registered objects must outlive the group they are added to.
+ * 
+ * @tparam CAPACITY The maximum number of registered objects
+ */
+template <uint8_t CAPACITY = 8>
+class TimerGroup
+{
+    public:
+        /**
+         * @brief Construct a new, empty TimerGroup
+         */
+        TimerGroup(): entryCount(0), snapshot(BasicTimer::now()){};
+
+        /**
+         * @brief Registers a timer, blinker, TimerQueue or any other object
+         *        with timeRemaining(current) and, optionally, run(current).
+         * 
+         * @return true if the object was added
+         * @return false if the group is full
+         */
+        template <typename T>
+        bool add(T& object) { return add(&object, &remainingOf<T>, runnerOf<T>(0)); };
+
+        /**
+         * @brief Takes a new clock snapshot and runs every member against it.
+         *        Should be called once per loop.
+         */
+        void run()
+        {
+            snapshot = BasicTimer::now();
+            for (uint8_t i = 0; i < entryCount; i++) {
+                if (entries[i].run != nullptr) entries[i].run(entries[i].object, snapshot);
+            }
+        }
+
+        /**
+         * @brief The clock snapshot taken by the last run()
+         * 
+         * @return BasicTimer::TickType 
+         */
+        BasicTimer::TickType now() const { return snapshot; };
+
+        /**
+         * @brief The time in milliseconds from the last snapshot until the 
+         *        first member is due.
+         * 
+         * @return unsigned long The time in milliseconds, 0 if something is 
+         *         already due, or BasicTimer::NoDeadline if nothing is pending
+         */
+        unsigned long timeUntilNext() const
+        {
+            unsigned long earliest = BasicTimer::NoDeadline;
+            for (uint8_t i = 0; i < entryCount; i++) {
+                unsigned long remaining = entries[i].remaining(entries[i].object, snapshot);
+                if (remaining < earliest) earliest = remaining;
+            }
+            return earliest;
+        }
+
+        /**
+         * @brief The number of registered objects
+         * 
+         * @return uint8_t 
+         */
+        uint8_t size() const { return entryCount; };
+
+    protected:
+        /**
+         * @brief Type erased registered object
+         */
+        typedef unsigned long (*RemainingFunction)(const void* object, BasicTimer::TickType current);
+        typedef void (*RunFunction)(void* object, BasicTimer::TickType current);
+
+        struct Entry
+        {
+            void* object;
+            RemainingFunction remaining;
+            RunFunction run;
+        };
+
+        Entry entries[CAPACITY];
+        uint8_t entryCount;
+        BasicTimer::TickType snapshot;
+
+        bool add(void* object, RemainingFunction remaining, RunFunction run)
+        {
+            if (entryCount >= CAPACITY) return false;
+            entries[entryCount].object = object;
+            entries[entryCount].remaining = remaining;
+            entries[entryCount].run = run;
+            entryCount++;
+            return true;
+        }
+
+        template <typename T>
+        static unsigned long remainingOf(const void* object, BasicTimer::TickType current)
+        {
+            return static_cast<const T*>(object)->timeRemaining(current);
+        }
+
+        template <typename T>
+        static void runOf(void* object, BasicTimer::TickType current)
+        {
+            static_cast<T*>(object)->run(current);
+        }
+
+        /**
+         * @brief runOf<T> if T has a run(current) member, picked over the 
+         *        nullptr overload below by the better match for 0
+         */
+        template <typename T>
+        static auto runnerOf(int) -> decltype((void)static_cast<T*>(nullptr)->run(BasicTimer::TickType()), RunFunction())
+        {
+            return &runOf<T>;
+        }
+
+        template <typename T>
+        static RunFunction runnerOf(long) { return nullptr; }
+};
+
+#endif /* _BASIC_TIMER_TIMER_GROUP_H_ */
@@ -0,0 +1,388 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerPool.h
+//!  @brief TimerPool class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_TIMER_POOL_H_
+#define _BASIC_TIMER_TIMER_POOL_H_
+
+#include "./TimerCore.h"
+#include "./TimerDelegate.h"
+
+/**
+ * @brief A fixed number of timer slots handed out on demand with after() 
+ *        and every(), for timeouts that do not deserve their own object.
+ * 
+ *    A CallbackTimer has to be declared for every timeout a sketch might 
+ *    need, which does not suit transient ones like "retry this packet in 
+ *    200 ms".  A TimerPool owns N slots and lends them out:
+ * 
+ *        TimerPool<8> pool;
+ *        TimerPool<8>::Handle retry = pool.after(200, resend);
+ *        pool.every(1000, TimerDelegate::bind<Sensor, &Sensor::poll>(sensor));
+ *        ...
+ *        pool.cancel(retry);       // safe even if retry already fired
+ *        ...
+ *        void loop() { pool.run(); }
+ * 
+ *    Free slots are kept on a linked free list, so after(), every() and 
+ *    cancel() take constant time, and nothing is ever allocated.  A one 
+ *    shot slot returns to the free list just before its callback runs, so
+ *    the callback may start new timers.
+ * 
+ *    A Handle packs the slot number with the slot's generation, which 
+ *    changes every time the slot is freed.  cancel() and isActive() on a 
+ *    handle whose timer has fired or been cancelled do nothing, even if the
+ *    slot has since been reused.  The generation is 8 bits, so a handle is
+ *    only mistaken for a new timer in the same slot after that slot has 
+ *    been reused 255 times.  InvalidHandle (0) is never handed out and is
+ *    returned when the pool is full.
+ * 
+ * @tparam N The number of slots, 1 to 254
+ * @tparam Clock The clock policy used for timestamps
+ */
+template <uint8_t N, typename Clock = MillisClock>
+class TimerPool
+{
+    static_assert(N >= 1 && N < 255, "TimerPool holds 1 to 254 timers");
+
+    public:
+        /**
+         * @brief The timestamp type of the clock policy
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief Identifies one timer started with after() or every().
+         *        Generation in the high byte, slot in the low byte.
+         */
+        typedef uint16_t Handle;
+
+        /**
+         * @brief A handle that never refers to a timer
+         */
+        static constexpr Handle InvalidHandle = 0;
+
+        /**
+         * @brief Returned by timeRemaining() when no timer is pending
+         */
+        static constexpr TickType NoDeadline = static_cast<TickType>(~TickType(0));
+
+        /**
+         * @brief Construct a new TimerPool with every slot free
+         */
+        TimerPool(): freeHead(0), activeCount(0)
+        {
+            for (uint8_t i = 0; i < N; i++) {
+                slots[i].lastReset = 0;
+                slots[i].timeout = 0;
+                slots[i].generation = 1;
+                slots[i].flags = 0;
+                slots[i].nextFree = (i + 1 < N) ? i + 1 : EndOfList;
+            }
+        };
+
+        /**
+         * @brief Starts a one shot timer
+         * 
+         * @param timeout The time until the callback runs, in clock ticks
+         * @param callback The function to call once
+         * @return Handle The timer's handle, or InvalidHandle if the pool 
+         *         is full
+         */
+        Handle after(TickType timeout, TimerDelegate callback)
+        {
+            return start(timeout, callback, 0, Clock::now());
+        };
+
+        /**
+         * @brief Starts a periodic timer.  Its deadline moves forward by 
+         *        exactly one period each time, so it does not drift.
+         * 
+         * @param period The time between calls, in clock ticks
+         * @param callback The function to call every period
+         * @return Handle The timer's handle, or InvalidHandle if the pool 
+         *         is full
+         */
+        Handle every(TickType period, TimerDelegate callback)
+        {
+            return start(period, callback, PeriodicFlag, Clock::now());
+        };
+
+        /**
+         * @brief after() measured from a timestamp taken earlier
+         */
+        Handle after(TickType timeout, TimerDelegate callback, TickType current)
+        {
+            return start(timeout, callback, 0, current);
+        };
+
+        /**
+         * @brief every() measured from a timestamp taken earlier
+         */
+        Handle every(TickType period, TimerDelegate callback, TickType current)
+        {
+            return start(period, callback, PeriodicFlag, current);
+        };
+
+        /**
+         * @brief Stops a timer and frees its slot
+         * 
+         * @param handle The handle from after() or every()
+         * @return true if the timer was pending and is now cancelled
+         * @return false if the handle is stale or invalid
+         */
+        bool cancel(Handle handle)
+        {
+            if (!isActive(handle)) return false;
+            release(slotOf(handle));
+            return true;
+        };
+
+        /**
+         * @brief Checks if a handle still refers to a pending timer
+         */
+        bool isActive(Handle handle) const
+        {
+            uint8_t slot = slotOf(handle);
+            return slot < N && 
+                   slots[slot].generation == generationOf(handle) && 
+                   (slots[slot].flags & ActiveFlag);
+        };
+
+        /**
+         * @brief Runs every expired timer; call every loop()
+         * 
+         * @return uint8_t The number of callbacks made
+         */
+        uint8_t run() { return run(Clock::now()); };
+
+        /**
+         * @brief Runs every timer expired at the given timestamp
+         * 
+         *        A timer started after the timestamp was taken, by one of 
+         *        this pass's callbacks for example, counts as just started 
+         *        and is left for a later pass, by the same rule as 
+         *        BasicTimer::elapsedTime(current).
+         * 
+         * @param current The current clock timestamp
+         * @return uint8_t The number of callbacks made
+         */
+        uint8_t run(TickType current)
+        {
+            uint8_t calls = 0;
+            for (uint8_t i = 0; i < N; i++) {
+                Slot& slot = slots[i];
+                if (!(slot.flags & ActiveFlag)) continue;
+                TickType elapsed = elapsedIn(slot, current);
+                if (elapsed <= slot.timeout) continue;
+
+                TimerDelegate callback = slot.callback;
+                if (slot.flags & PeriodicFlag) {
+                    if (slot.timeout == 0) {
+                        slot.lastReset = current;
+                    } else {
+                        TickType periods = static_cast<TickType>((elapsed - 1) / slot.timeout);
+                        slot.lastReset = static_cast<TickType>(slot.lastReset + periods * slot.timeout);
+                    }
+                } else {
+                    release(i);
+                }
+                if (callback) callback();
+                calls++;
+            }
+            return calls;
+        };
+
+        /**
+         * @brief The time until the pending timer with the given handle 
+         *        runs
+         * 
+         * @param handle The handle from after() or every()
+         * @param current The current clock timestamp
+         * @return TickType The remaining time, 0 if overdue, NoDeadline if 
+         *         the handle is stale
+         */
+        TickType timeRemaining(Handle handle, TickType current) const
+        {
+            if (!isActive(handle)) return NoDeadline;
+            return remainingIn(slots[slotOf(handle)], current);
+        };
+
+        /**
+         * @brief The time until the next timer in the pool runs
+         * 
+         * @param current The current clock timestamp
+         * @return TickType The remaining time, 0 if overdue, NoDeadline if 
+         *         nothing is pending
+         */
+        TickType timeRemaining(TickType current) const
+        {
+            TickType next = NoDeadline;
+            for (uint8_t i = 0; i < N; i++) {
+                if (!(slots[i].flags & ActiveFlag)) continue;
+                TickType remaining = remainingIn(slots[i], current);
+                if (remaining < next) next = remaining;
+            }
+            return next;
+        };
+
+        /**
+         * @brief The number of pending timers
+         */
+        uint8_t active() const { return activeCount; };
+
+        /**
+         * @brief The number of free slots
+         */
+        uint8_t available() const { return N - activeCount; };
+
+        /**
+         * @brief Cancels every pending timer.  All outstanding handles 
+         *        become stale.
+         */
+        void clear()
+        {
+            for (uint8_t i = 0; i < N; i++) {
+                if (slots[i].flags & ActiveFlag) release(i);
+            }
+        };
+
+    protected:
+        /**
+         * @brief Marks the end of the free list
+         */
+        static constexpr uint8_t EndOfList = 0xFF;
+
+        /**
+         * @brief Bits of Slot::flags
+         */
+        static constexpr uint8_t ActiveFlag = 0x1;
+        static constexpr uint8_t PeriodicFlag = 0x2;
+
+        /**
+         * @brief One timer.  It expires when more than timeout ticks have 
+         *        elapsed and periodic timers advance the same way as 
+         *        BasicTimer::advance().
+         */
+        struct Slot
+        {
+            TickType lastReset;
+            TickType timeout;
+            TimerDelegate callback;
+            uint8_t generation;
+            uint8_t flags;
+            uint8_t nextFree;
+        };
+
+        Slot slots[N];
+        uint8_t freeHead;
+        uint8_t activeCount;
+
+        static uint8_t slotOf(Handle handle) { return handle & 0xFF; };
+        static uint8_t generationOf(Handle handle) { return handle >> 8; };
+
+        Handle start(TickType timeout, TimerDelegate callback, uint8_t flags, TickType current)
+        {
+            if (freeHead == EndOfList) return InvalidHandle;
+            uint8_t i = freeHead;
+            Slot& slot = slots[i];
+            freeHead = slot.nextFree;
+            slot.lastReset = current;
+            slot.timeout = timeout;
+            slot.callback = callback;
+            slot.flags = flags | ActiveFlag;
+            activeCount++;
+            return static_cast<Handle>((Handle(slot.generation) << 8) | i);
+        };
+
+        void release(uint8_t i)
+        {
+            Slot& slot = slots[i];
+            slot.flags = 0;
+            slot.callback = nullptr;
+            if (++slot.generation == 0) slot.generation = 1;
+            slot.nextFree = freeHead;
+            freeHead = i;
+            activeCount--;
+        };
+
+        /**
+         * @brief The time since a slot was started or last advanced, or 0 
+         *        if it was started after the timestamp
+         */
+        static TickType elapsedIn(const Slot& slot, TickType current)
+        {
+            TickType elapsed = static_cast<TickType>(current - slot.lastReset);
+            if (elapsed > slot.timeout + (NoDeadline - slot.timeout) / 2) return 0;
+            return elapsed;
+        };
+
+        static TickType remainingIn(const Slot& slot, TickType current)
+        {
+            TickType elapsed = elapsedIn(slot, current);
+            return (elapsed > slot.timeout) ? 0 : static_cast<TickType>(slot.timeout - elapsed + 1);
+        };
+};
+
+template <uint8_t N, typename Clock>
+constexpr typename TimerPool<N, Clock>::Handle TimerPool<N, Clock>::InvalidHandle;
+
+template <uint8_t N, typename Clock>
+constexpr typename TimerPool<N, Clock>::TickType TimerPool<N, Clock>::NoDeadline;
+
+#endif /* _BASIC_TIMER_TIMER_POOL_H_ */
@@ -0,0 +1,475 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerQueue.h
+//!  @brief TimerQueue deadline ordered scheduler class definitions
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+#ifndef _BASIC_TIMER_TIMER_QUEUE_H_
+#define _BASIC_TIMER_TIMER_QUEUE_H_
+
+#include "./TimerCore.h"
+#include "./CallbackTimer.h"
+
+class TimerQueue;
+
+/**
+ * @brief A callback timer that is kept in deadline order by a TimerQueue.
+ * 
+ *    A QueuedTimer holds the same settings as a CallbackTimer (timeout, 
+ *    callback and run mode).  It is started and stopped through a TimerQueue, 
+ *    which links it into a list sorted by expiry time, so no memory is
+ *    allocated and the earliest timer is always at the front.
+ * 
+ *    A started QueuedTimer is linked into its queue, so it must not be 
+ *    destroyed or copied while it is running.
+ * 
+ * @see TimerQueue
+ */
+class QueuedTimer
+{
+    friend class TimerQueue;
+
+    public:
+        /**
+         * @brief onExpire callback handler type
+         */
+        typedef CallbackTimer::OnExpireFunction OnExpireFunction;
+
+        /**
+         * @brief Construct a new QueuedTimer object with the provided timeout and callback
+         * 
+         * @param timeout The timeout in milliseconds
+         * @param callback The onExpire callback function
+         * @param mode The timer mode - defaults to TIMER_RUN_MODE_ONE_SHOT
+         */
+        QueuedTimer(unsigned long timeout = 500, 
+                    OnExpireFunction callback = nullptr, 
+                    TimerRunMode mode = TIMER_RUN_MODE_ONE_SHOT):
+                        next(nullptr),
+                        pprev(nullptr),
+                        expireAt(0),
+                        storedTimeout(timeout),
+                        expiredCallback(callback),
+                        stateFlags(static_cast<uint8_t>(mode) & TimerModeMask)
+                        {};
+
+        QueuedTimer(const QueuedTimer&) = delete;
+        QueuedTimer& operator=(const QueuedTimer&) = delete;
+
+        /**
+         * @brief Set the timer's timeout to the supplied value.  Takes effect 
+         *        the next time the timer is started.
+         * 
+         * @param timeout The new timer period in milliseconds
+         */
+        void setTimeout(unsigned long timeout){ storedTimeout = timeout; };
+
+        /**
+         * @brief Returns the timer's stored timeout time in milliseconds
+         * 
+         * @return unsigned long 
+         */
+        unsigned long timeout() const { return storedTimeout; };
+
+        /**
+         * @brief Assign a callback function to be called on time expire
+         * 
+         * @param callback The onExpire callback function
+         */
+        void onExpire(OnExpireFunction callback){ expiredCallback = callback; };
+
+        /**
+         * @brief Sets the timer mode.  
+         * 
+         * @param mode The TimerRunMode
+         * @see TimerRunMode
+         */
+        void setMode(TimerRunMode mode) {
+            uint8_t currentState = stateFlags & (~TimerModeMask);
+            uint8_t newMode = mode & TimerModeMask;
+            stateFlags = currentState | newMode;
+        }
+
+        /**
+         * @brief Gets the current timer mode
+         * 
+         * @return TimerRunMode 
+         */
+        TimerRunMode mode() const {
+            return static_cast<TimerRunMode>(stateFlags & TimerModeMask);
+        }
+
+        /**
+         * @brief Gets if the time has been started
+         * 
+         * @return bool
+         */
+        bool hasStarted() const {
+            return (stateFlags & (1 << StartFlagBit));
+        }
+
+        /**
+         * @brief Checks if the time has expired previously
+         * 
+         * @return true if the timeout has reached expiration
+         * @return false if not
+         */
+        bool hasPreviouslyExpired() const {
+            return (stateFlags & (1 << ExpireFlagBit));
+        }
+
+        /**
+         * @brief Checks if the timer is currently linked into a queue 
+         *        and waiting to expire.
+         * 
+         * @return bool
+         */
+        bool isPending() const { return pprev != nullptr; };
+
+        /**
+         * @brief The timestamp in milliseconds at which the timer expires.  
+         *        Only meaningful while the timer is pending.
+         * 
+         * @return BasicTimer::TickType 
+         */
+        BasicTimer::TickType deadline() const { return expireAt; };
+
+    protected:
+        /**
+         * @brief Constexpr mask for getting/setting the timer mode from 
+         *        stateFlags
+         */
+        static constexpr uint8_t TimerModeMask = 0x3;
+
+        /**
+         * @brief Bit position in stateFlags for the start flag
+         */
+        static constexpr uint8_t StartFlagBit = 6;
+
+        /**
+         * @brief Bit position in stateFlags for the expired flag
+         */
+        static constexpr uint8_t ExpireFlagBit = 7;
+
+        /**
+         * @brief Next (later) timer in the queue
+         */
+        QueuedTimer* next;
+
+        /**
+         * @brief Pointer to the link that points at this timer, 
+         *        nullptr when the timer is not in a queue.
+         */
+        QueuedTimer** pprev;
+
+        /**
+         * @brief The timestamp in milliseconds at which the timer expires
+         */
+        BasicTimer::TickType expireAt;
+
+        /**
+         * @brief The timeout value in milliseconds
+         */
+        unsigned long storedTimeout;
+
+        /**
+         * @brief On expire callback pointer storage
+         */
+        OnExpireFunction expiredCallback;
+
+        /**
+         * @brief State storage as bit flags to reduce memory footprint
+         */
+        uint8_t stateFlags;
+};
+
+/**
+ * @brief Deadline ordered list of QueuedTimers.
+ * 
+ *    The queue keeps its timers sorted by expiry time, so the main loop can 
+ *    ask how long it has before anything is due with timeUntilNext() 
+ *    instead of checking every timer.  Finding and firing the next timer 
+ *    and stopping any timer are O(1).  Starting a timer is O(n) in the 
+ *    number of timers due before it.
+ * 
+ *    Deadlines are compared with signed differences, so ordering is correct
+ *    across millis() rollover as long as no timeout is longer than ~24 days.
+ */
+class TimerQueue
+{
+    public:
+        /**
+         * @brief Value returned by timeUntilNext() when the queue is empty
+         */
+        static constexpr unsigned long NoDeadline = BasicTimer::NoDeadline;
+
+        /**
+         * @brief Construct a new, empty TimerQueue
+         */
+        TimerQueue(): head(nullptr){};
+
+        TimerQueue(const TimerQueue&) = delete;
+        TimerQueue& operator=(const TimerQueue&) = delete;
+
+        /**
+         * @brief Starts or restarts a timer with its previously set timeout
+         *        and mode.
+         * 
+         * @param timer The timer to start
+         */
+        void start(QueuedTimer& timer)
+        {
+            restart(timer, BasicTimer::now());
+        }
+
+        /**
+         * @brief Sets the timeout and mode of a timer, then starts it
+         * 
+         * @param timer The timer to start
+         * @param timeout The timeout in milliseconds
+         * @param mode The timer mode - defaults to TIMER_RUN_MODE_ONE_SHOT
+         */
+        void begin(QueuedTimer& timer, unsigned long timeout, 
+                   TimerRunMode mode = TIMER_RUN_MODE_ONE_SHOT)
+        {
+            timer.setTimeout(timeout);
+            timer.setMode(mode);
+            start(timer);
+        }
+
+        /**
+         * @brief Stops a timer, removing it from the queue
+         * 
+         * @param timer The timer to stop
+         */
+        void stop(QueuedTimer& timer)
+        {
+            detach(timer);
+            bitClear(timer.stateFlags, QueuedTimer::StartFlagBit);
+        }
+
+        /**
+         * @brief Runs the queue.
+         * 
+         *      This function should be called from the main loop and it 
+         *      will execute the callback of every timer that is due, in
+         *      deadline order.
+         */
+        void service()
+        {
+            service(BasicTimer::now());
+        }
+
+        /**
+         * @brief Runs the queue against a timestamp taken earlier with
+         *        BasicTimer::now().
+         * 
+         * @param current The timestamp to run against
+         */
+        void service(BasicTimer::TickType current)
+        {
+            while (head != nullptr && isDue(*head, current)) {
+                QueuedTimer& timer = *head;
+                detach(timer);
+                bitSet(timer.stateFlags, QueuedTimer::ExpireFlagBit);
+                TimerRunMode runMode = timer.mode();
+                if (runMode == TIMER_RUN_MODE_CONTINUOUS || 
+                    (runMode != TIMER_RUN_MODE_ONE_SHOT && timer.storedTimeout == 0)) {
+                    restart(timer, current);
+                } else if (runMode != TIMER_RUN_MODE_ONE_SHOT) {
+                    advance(timer, current, runMode == TIMER_RUN_MODE_PERIODIC);
+                }
+                if (timer.expiredCallback != nullptr) {
+                    timer.expiredCallback();
+                }
+            }
+        }
+
+        /**
+         * @brief Alias for service() so a queue can join a TimerGroup
+         */
+        void run(BasicTimer::TickType current) { service(current); };
+
+        /**
+         * @brief Checks if no timers are waiting in the queue
+         * 
+         * @return bool
+         */
+        bool isEmpty() const { return head == nullptr; };
+
+        /**
+         * @brief The timer that will expire first, or nullptr if the 
+         *        queue is empty.
+         * 
+         * @return QueuedTimer* 
+         */
+        QueuedTimer* peek() const { return head; };
+
+        /**
+         * @brief The timestamp in milliseconds at which the first timer 
+         *        expires.  Only meaningful if the queue is not empty.
+         * 
+         * @return BasicTimer::TickType 
+         */
+        BasicTimer::TickType nextDeadline() const 
+        { 
+            return (head != nullptr) ? head->expireAt : 0; 
+        };
+
+        /**
+         * @brief The time in milliseconds until the first timer expires.
+         * 
+         *        Returns 0 if a timer is already due and NoDeadline if 
+         *        the queue is empty.
+         * 
+         * @return unsigned long 
+         */
+        unsigned long timeUntilNext() const
+        {
+            return timeUntilNext(BasicTimer::now());
+        }
+
+        /**
+         * @brief The time in milliseconds until the first timer expires,
+         *        measured from a timestamp taken earlier with BasicTimer::now().
+         * 
+         * @param current The timestamp to measure from
+         * @return unsigned long 
+         */
+        unsigned long timeUntilNext(BasicTimer::TickType current) const
+        {
+            if (head == nullptr) return NoDeadline;
+            if (isDue(*head, current)) return 0;
+            else return head->expireAt - current;
+        }
+
+        /**
+         * @brief Alias for timeUntilNext() so a queue can join a TimerGroup
+         */
+        unsigned long timeRemaining(BasicTimer::TickType current) const { return timeUntilNext(current); };
+
+    protected:
+        /**
+         * @brief The earliest timer in the queue
+         */
+        QueuedTimer* head;
+
+        /**
+         * @brief Checks if a timer's deadline has been reached
+         */
+        static bool isDue(const QueuedTimer& timer, BasicTimer::TickType current)
+        {
+            return static_cast<int32_t>(current - timer.expireAt) >= 0;
+        }
+
+        /**
+         * @brief (Re)inserts a timer with a deadline relative to the 
+         *        supplied timestamp.
+         */
+        void restart(QueuedTimer& timer, BasicTimer::TickType current)
+        {
+            detach(timer);
+            bitSet(timer.stateFlags, QueuedTimer::StartFlagBit);
+            bitClear(timer.stateFlags, QueuedTimer::ExpireFlagBit);
+            timer.expireAt = current + timer.storedTimeout + 1;
+            attach(timer);
+        }
+
+        /**
+         * @brief Moves a periodic timer's deadline on by one period, keeping
+         *        its phase.  In catch up mode an overdue deadline is left in 
+         *        the past so that service() fires it again straight away.
+         */
+        void advance(QueuedTimer& timer, BasicTimer::TickType current, bool skipMissed)
+        {
+            timer.expireAt += timer.storedTimeout;
+            if (skipMissed && isDue(timer, current)) {
+                BasicTimer::TickType periods = (current - timer.expireAt) / timer.storedTimeout + 1;
+                timer.expireAt += periods * timer.storedTimeout;
+            }
+            bitClear(timer.stateFlags, QueuedTimer::ExpireFlagBit);
+            attach(timer);
+        }
+
+        /**
+         * @brief Links a timer in after every timer due at or before it
+         */
+        void attach(QueuedTimer& timer)
+        {
+            QueuedTimer** link = &head;
+            while (*link != nullptr && 
+                   static_cast<int32_t>((*link)->expireAt - timer.expireAt) <= 0) {
+                link = &(*link)->next;
+            }
+            timer.next = *link;
+            if (timer.next != nullptr) timer.next->pprev = &timer.next;
+            timer.pprev = link;
+            *link = &timer;
+        }
+
+        /**
+         * @brief Unlinks a timer from the queue
+         */
+        void detach(QueuedTimer& timer)
+        {
+            if (timer.pprev == nullptr) return;
+            *timer.pprev = timer.next;
+            if (timer.next != nullptr) timer.next->pprev = timer.pprev;
+            timer.next = nullptr;
+            timer.pprev = nullptr;
+        }
+};
+
+#endif /* _BASIC_TIMER_TIMER_QUEUE_H_ */
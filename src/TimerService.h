@@ -0,0 +1,516 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerService.h
+//!  @brief Thread-safe TimerService class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_TIMER_SERVICE_H_
+#define _BASIC_TIMER_TIMER_SERVICE_H_
+
+/*
+ *  TimerService needs the C++ standard library's <atomic>, <thread>, 
+ *  <mutex> and <condition_variable>, so it is not included by BasicTimer.h.
+ *  Include it directly on ESP32 and on Linux hosts.  Other Arduino cores, 
+ *  including the RP2040 ones, do not provide std::thread.
+ */
+
+#if defined(ARDUINO) && !defined(ESP32)
+#error "TimerService needs std::thread, which this board's core does not provide.  It is only available on ESP32 and host builds."
+#endif
+
+#include "./TimerCore.h"
+#include "./TimerDelegate.h"
+#include <stddef.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief A bounded, lock-free queue that any number of threads may push to
+ *        and pop from.
+ * 
+ *    Each cell carries a sequence number that says whether it is ready to 
+ *    be written or read on the current lap, so producers and consumers 
+ *    only contend on their own position counter.
+ * 
+ * @tparam T The element type, copied in and out by value
+ * @tparam SIZE The number of elements, a power of two
+ */
+template <typename T, size_t SIZE>
+class TimerServiceQueue
+{
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "TimerServiceQueue size must be a power of two");
+
+    public:
+        TimerServiceQueue(): enqueuePosition(0), dequeuePosition(0)
+        {
+            for (size_t i = 0; i < SIZE; i++) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        };
+
+        TimerServiceQueue(const TimerServiceQueue&) = delete;
+        TimerServiceQueue& operator=(const TimerServiceQueue&) = delete;
+
+        /**
+         * @brief Adds a value.  Safe from any thread.
+         * 
+         * @return false if the queue was full
+         */
+        bool push(const T& value)
+        {
+            size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells[position & Mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            cell->value = value;
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest value.  Safe from any thread.
+         * 
+         * @return false if the queue was empty
+         */
+        bool pop(T& value)
+        {
+            size_t position = dequeuePosition.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells[position & Mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position + 1);
+                if (difference == 0) {
+                    if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            value = cell->value;
+            cell->sequence.store(position + Mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Checks if the queue is empty.  Only a hint while other 
+         *        threads are pushing or popping.
+         */
+        bool empty() const
+        {
+            return dequeuePosition.load(std::memory_order_acquire) == enqueuePosition.load(std::memory_order_acquire);
+        }
+
+    protected:
+        static constexpr size_t Mask = SIZE - 1;
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        Cell cells[SIZE];
+        alignas(64) std::atomic<size_t> enqueuePosition;
+        alignas(64) std::atomic<size_t> dequeuePosition;
+};
+
+/**
+ * @brief A set of callback timers that any thread or core may arm and 
+ *        cancel, run by a single dispatcher.
+ * 
+ *    A CallbackTimer is not safe to start() or stop() from another core or
+ *    RTOS task while run() is executing, because its flags are updated with
+ *    plain read-modify-write operations.  In a TimerService only the 
+ *    dispatcher touches timer state.  arm() and cancel() push commands 
+ *    onto a lock-free queue that the dispatcher drains at the start of 
+ *    every pass, so they may be called from any thread, including from 
+ *    callbacks.
+ * 
+ *    The dispatcher is either a thread started by begin(), which sleeps 
+ *    until the next deadline or command, or your own code calling run() 
+ *    (for example a FreeRTOS task on the other ESP32 core).  With workers > 0, 
+ *    begin() also starts that many worker threads and the dispatcher hands 
+ *    callbacks to them instead of running them itself.  A periodic 
+ *    callback may then run again before its previous call has returned.
+ *    If the worker queue is full the dispatcher runs the callback itself.
+ * 
+ *    Slots behave like a CallbackTimer: TIMER_RUN_MODE_ONE_SHOT fires once,
+ *    TIMER_RUN_MODE_CONTINUOUS resets to the time it fired, and both 
+ *    periodic modes advance by whole periods.
+ * 
+ * @tparam CAPACITY The number of timer slots
+ * @tparam QUEUE_SIZE The size of the command and worker queues, a power of two
+ * @tparam Clock The clock policy used for timestamps, which must be 
+ *         safe to read from any thread
+ */
+template <uint16_t CAPACITY = 16, size_t QUEUE_SIZE = 64, typename Clock = MillisClock>
+class TimerService
+{
+    public:
+        /**
+         * @brief The timestamp type of the clock policy
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief onExpire callback handler type
+         */
+        typedef TimerDelegate OnExpireFunction;
+
+        /**
+         * @brief Construct a new TimerService with every slot disarmed
+         * 
+         * @param workers The number of worker threads begin() starts to 
+         *        run callbacks, or 0 to run them on the dispatcher
+         */
+        TimerService(uint8_t workers = 0): workerCount(workers), running(false), 
+                                            dispatcherSleeping(false), idleWorkers(0)
+        {
+            for (uint16_t i = 0; i < CAPACITY; i++) {
+                slots[i].armed = false;
+                slots[i].mode = TIMER_RUN_MODE_ONE_SHOT;
+            }
+        };
+
+        TimerService(const TimerService&) = delete;
+        TimerService& operator=(const TimerService&) = delete;
+
+        ~TimerService() { end(); };
+
+        /**
+         * @brief Starts the dispatcher thread and any worker threads
+         */
+        void begin()
+        {
+            if (running.exchange(true)) return;
+            for (uint8_t i = 0; i < workerCount && i < MaxWorkers; i++) {
+                workers[i] = std::thread(&TimerService::workerLoop, this);
+            }
+            dispatcher = std::thread(&TimerService::dispatcherLoop, this);
+        }
+
+        /**
+         * @brief Stops and joins the threads started by begin().  Callbacks
+         *        already handed to workers are run before they exit.
+         */
+        void end()
+        {
+            if (!running.exchange(false)) return;
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                dispatcherWake.notify_all();
+                workerWake.notify_all();
+            }
+            dispatcher.join();
+            for (uint8_t i = 0; i < workerCount && i < MaxWorkers; i++) {
+                workers[i].join();
+            }
+        }
+
+        /**
+         * @brief Arms or re-arms a slot.  Safe from any thread.
+         * 
+         * @param slot The slot number, less than CAPACITY
+         * @param timeout The timeout in clock ticks
+         * @param callback The onExpire callback
+         * @param mode The timer mode - defaults to TIMER_RUN_MODE_ONE_SHOT
+         * @return true if the request was queued
+         * @return false if the command queue is full
+         */
+        bool arm(uint16_t slot, TickType timeout, const OnExpireFunction& callback, 
+                 TimerRunMode mode = TIMER_RUN_MODE_ONE_SHOT)
+        {
+            Command command;
+            command.slot = slot;
+            command.mode = static_cast<uint8_t>(mode);
+            command.timeout = timeout;
+            command.start = Clock::now();
+            command.callback = callback;
+            return send(command);
+        }
+
+        /**
+         * @brief Disarms a slot.  Safe from any thread.  A callback already 
+         *        handed to a worker still runs.
+         * 
+         * @param slot The slot number, less than CAPACITY
+         * @return true if the request was queued
+         * @return false if the command queue is full
+         */
+        bool cancel(uint16_t slot)
+        {
+            Command command;
+            command.slot = slot;
+            command.mode = CancelCommand;
+            return send(command);
+        }
+
+        /**
+         * @brief Applies queued commands and runs or hands off every callback 
+         *        that is due.  Call from one thread only, and not while the 
+         *        begin() dispatcher is running.
+         * 
+         * @return unsigned int The number of timers that fired
+         */
+        unsigned int run()
+        {
+            Command command;
+            while (commands.pop(command)) {
+                apply(command);
+            }
+            TickType current = Clock::now();
+            unsigned int fired = 0;
+            for (uint16_t i = 0; i < CAPACITY; i++) {
+                Slot& slot = slots[i];
+                if (!slot.armed || !slot.timer.hasExpired(current)) continue;
+                if (slot.mode == TIMER_RUN_MODE_ONE_SHOT) {
+                    slot.armed = false;
+                } else if (slot.mode == TIMER_RUN_MODE_CONTINUOUS) {
+                    slot.timer.reset(current);
+                } else {
+                    slot.timer.advance(current);
+                }
+                fired++;
+                if (slot.callback) execute(slot.callback);
+            }
+            return fired;
+        }
+
+        /**
+         * @brief The time from now until the next armed slot is due, 
+         *        considering only commands already applied.  Call from the 
+         *        dispatcher thread only.
+         * 
+         * @return TickType The time in clock ticks, 0 if something is due, 
+         *         or NoDeadline if nothing is armed
+         */
+        TickType timeUntilNext() const
+        {
+            TickType current = Clock::now();
+            TickType earliest = NoDeadline;
+            for (uint16_t i = 0; i < CAPACITY; i++) {
+                if (!slots[i].armed) continue;
+                TickType remaining = slots[i].timer.timeRemaining(current);
+                if (remaining < earliest) earliest = remaining;
+            }
+            return earliest;
+        }
+
+        /**
+         * @brief Returned by timeUntilNext() when nothing is armed
+         */
+        static constexpr TickType NoDeadline = static_cast<TickType>(~TickType(0));
+
+    protected:
+        /**
+         * @brief The most worker threads begin() will start
+         */
+        static constexpr uint8_t MaxWorkers = 16;
+
+        /**
+         * @brief Command mode value that cancels a slot instead of arming it
+         */
+        static constexpr uint8_t CancelCommand = 0xFF;
+
+        /**
+         * @brief The longest the dispatcher thread sleeps between passes
+         */
+        static constexpr unsigned long MaxSleepMicros = 100000UL;
+
+        /**
+         * @brief Timer state, owned by the dispatcher
+         */
+        struct Slot
+        {
+            TBasicTimer<Clock> timer;
+            OnExpireFunction callback;
+            uint8_t mode;
+            bool armed;
+        };
+
+        /**
+         * @brief An arm or cancel request
+         */
+        struct Command
+        {
+            TickType start;
+            TickType timeout;
+            OnExpireFunction callback;
+            uint16_t slot;
+            uint8_t mode;
+        };
+
+        Slot slots[CAPACITY];
+        TimerServiceQueue<Command, QUEUE_SIZE> commands;
+        TimerServiceQueue<OnExpireFunction, QUEUE_SIZE> jobs;
+
+        uint8_t workerCount;
+        std::atomic<bool> running;
+        std::atomic<bool> dispatcherSleeping;
+        std::atomic<uint8_t> idleWorkers;
+        std::mutex wakeMutex;
+        std::condition_variable dispatcherWake;
+        std::condition_variable workerWake;
+        std::thread dispatcher;
+        std::thread workers[MaxWorkers];
+
+        void apply(const Command& command)
+        {
+            if (command.slot >= CAPACITY) return;
+            Slot& slot = slots[command.slot];
+            if (command.mode == CancelCommand) {
+                slot.armed = false;
+                return;
+            }
+            slot.timer.setTimeout(command.timeout);
+            slot.timer.reset(command.start);
+            slot.callback = command.callback;
+            slot.mode = command.mode;
+            slot.armed = true;
+        }
+
+        /**
+         * @brief Queues a command and wakes the dispatcher if it is asleep.
+         * 
+         *        The fences pair with the ones in dispatcherLoop(): either 
+         *        this thread sees the dispatcher asleep and notifies it, or 
+         *        the dispatcher sees the command before it sleeps.  The 
+         *        mutex is only taken when the dispatcher is asleep.
+         */
+        bool send(const Command& command)
+        {
+            if (!commands.push(command)) return false;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (dispatcherSleeping.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                dispatcherWake.notify_one();
+            }
+            return true;
+        }
+
+        void execute(OnExpireFunction& callback)
+        {
+            if (workerCount == 0 || !running.load(std::memory_order_relaxed) || !jobs.push(callback)) {
+                callback();
+                return;
+            }
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (idleWorkers.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                workerWake.notify_one();
+            }
+        }
+
+        void dispatcherLoop()
+        {
+            while (running.load()) {
+                run();
+                TickType wait = timeUntilNext();
+                unsigned long sleepMicros = MaxSleepMicros;
+                if (wait < NoDeadline) {
+                    unsigned long long waitMicros = static_cast<unsigned long long>(wait) * 1000000ULL / Clock::TicksPerSecond;
+                    if (waitMicros < sleepMicros) sleepMicros = static_cast<unsigned long>(waitMicros);
+                }
+                if (sleepMicros == 0) continue;
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                dispatcherSleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (running.load() && commands.empty()) {
+                    dispatcherWake.wait_for(lock, std::chrono::microseconds(sleepMicros));
+                }
+                dispatcherSleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        void workerLoop()
+        {
+            OnExpireFunction job;
+            for (;;) {
+                if (jobs.pop(job)) {
+                    job();
+                    continue;
+                }
+                if (!running.load()) return;
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                idleWorkers.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (running.load() && jobs.empty()) {
+                    workerWake.wait(lock);
+                }
+                idleWorkers.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+};
+
+template <uint16_t CAPACITY, size_t QUEUE_SIZE, typename Clock>
+constexpr typename TimerService<CAPACITY, QUEUE_SIZE, Clock>::TickType TimerService<CAPACITY, QUEUE_SIZE, Clock>::NoDeadline;
+
+#endif /* _BASIC_TIMER_TIMER_SERVICE_H_ */
@@ -0,0 +1,507 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerSnapshot.h
+//!  @brief TimerSnapshot class and storage backend definitions
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_TIMER_SNAPSHOT_H_
+#define _BASIC_TIMER_TIMER_SNAPSHOT_H_
+
+#include "./TimerCore.h"
+#include "./BasicBlinker.h"
+#include "./CallbackTimer.h"
+
+#if defined(__AVR__)
+#include <avr/eeprom.h>
+#endif
+
+/**
+ * @brief Saves the state of a set of timers and blinkers to storage and 
+ *        restores it after a reset.
+ * 
+ *    After a brownout or watchdog reset every timer starts again from 
+ *    zero, so a 12 hour maintenance interval or a long retry backoff is 
+ *    lost or fires late.  A TimerSnapshot holds a list of registered 
+ *    BasicTimers, CallbackTimers, DelegateTimers and BasicBlinkers; save() 
+ *    writes each one's remaining time, timeout and state flags to a 
+ *    storage backend, and restore() early in setup() puts them back.
+ * 
+ *        TimerSnapshot<4> snapshot;
+ *        EepromTimerStorage eeprom;
+ *        void setup() {
+ *            snapshot.add(maintenanceTimer);
+ *            snapshot.add(statusBlinker);
+ *            if (!snapshot.restore(eeprom)) maintenanceTimer.start();
+ *        }
+ *        // and call snapshot.save(eeprom) periodically or on shutdown
+ * 
+ *    The blob is a 4 byte header (magic, format version, record count), 
+ *    10 bytes per timer and a Fletcher-16 checksum, all little endian.  
+ *    restore() reads the whole snapshot once into a buffer on the stack 
+ *    (12 bytes per registered object) and checks the header, the checksum
+ *    and that every record was saved from the same kind of object before 
+ *    changing anything.  It leaves the timers untouched if any read or 
+ *    check fails, so a blank EEPROM, a torn write, a failing storage 
+ *    backend or a changed registration list all read as "no snapshot".
+ *    Timers must be added in the same order on every boot.
+ * 
+ *    The clock does not run while the board is off or resetting.  
+ *    restore() can be told how long that took, when an RTC or the 
+ *    reset cause knows; otherwise each timer carries on from where it was
+ *    saved.
+ * 
+ *    A storage backend is any class with 
+ * 
+ *        bool read(uint16_t address, uint8_t* data, uint16_t length);
+ *        bool write(uint16_t address, const uint8_t* data, uint16_t length);
+ * 
+ *    EepromTimerStorage (AVR) and RamTimerStorage are provided here, and 
+ *    extras/host/FileTimerStorage.h saves to a file on a host.
+ * 
+ * @tparam CAPACITY The maximum number of registered objects
+ */
+template <uint8_t CAPACITY = 8>
+class TimerSnapshot
+{
+    public:
+        /**
+         * @brief The snapshot layout version, written in the header
+         */
+        static constexpr uint8_t FormatVersion = 1;
+
+        /**
+         * @brief Bytes in the header, in each record and in the checksum
+         */
+        static constexpr uint16_t HeaderSize = 4;
+        static constexpr uint16_t RecordSize = 10;
+        static constexpr uint16_t ChecksumSize = 2;
+
+        /**
+         * @brief Construct a new, empty TimerSnapshot
+         */
+        TimerSnapshot(): entryCount(0) {};
+
+        /**
+         * @brief Registers a timer or blinker to be saved and restored
+         * 
+         * @return true if the object was added
+         * @return false if the snapshot is full
+         */
+        bool add(BasicTimer& timer) { return add(&timer, KindBasicTimer, &saveTimer, &restoreTimer); };
+        bool add(BasicBlinker& blinker) { return add(&blinker, KindBlinker, &saveBlinker, &restoreBlinker); };
+
+        template <typename Callback, typename Stats>
+        bool add(TCallbackTimer<Callback, Stats>& timer) 
+        { 
+            return add(&timer, KindCallbackTimer, &saveCallbackTimer<Callback, Stats>, &restoreCallbackTimer<Callback, Stats>); 
+        };
+
+        /**
+         * @brief The number of bytes save() writes
+         */
+        uint16_t size() const { return HeaderSize + entryCount * RecordSize + ChecksumSize; };
+
+        /**
+         * @brief Writes the state of every registered object
+         * 
+         * @param storage The storage backend
+         * @param address Where in the storage the snapshot starts
+         * @return true if every write succeeded
+         */
+        template <typename Storage>
+        bool save(Storage& storage, uint16_t address = 0) const
+        {
+            return save(storage, address, BasicTimer::now());
+        }
+
+        /**
+         * @brief Writes the state of every registered object as of the 
+         *        given timestamp
+         */
+        template <typename Storage>
+        bool save(Storage& storage, uint16_t address, BasicTimer::TickType current) const
+        {
+            Checksum checksum;
+            uint8_t header[HeaderSize] = {MagicLow, MagicHigh, FormatVersion, entryCount};
+            checksum.add(header, HeaderSize);
+            if (!storage.write(address, header, HeaderSize)) return false;
+            address += HeaderSize;
+
+            for (uint8_t i = 0; i < entryCount; i++) {
+                Record record;
+                record.kind = entries[i].kind;
+                entries[i].save(entries[i].object, record, current);
+                uint8_t bytes[RecordSize];
+                record.pack(bytes);
+                checksum.add(bytes, RecordSize);
+                if (!storage.write(address, bytes, RecordSize)) return false;
+                address += RecordSize;
+            }
+
+            uint8_t sum[ChecksumSize];
+            checksum.pack(sum);
+            return storage.write(address, sum, ChecksumSize);
+        }
+
+        /**
+         * @brief Restores every registered object from a saved snapshot
+         * 
+         * @param storage The storage backend
+         * @param address Where in the storage the snapshot starts
+         * @param offTime How long the clock was stopped between save() and 
+         *        now, in milliseconds, if known
+         * @return true if the snapshot was valid and has been applied
+         * @return false if there was no valid snapshot for this set of 
+         *         objects; nothing is changed
+         */
+        template <typename Storage>
+        bool restore(Storage& storage, uint16_t address = 0, unsigned long offTime = 0)
+        {
+            return restore(storage, address, offTime, BasicTimer::now());
+        }
+
+        /**
+         * @brief Restores every registered object, measuring remaining 
+         *        time from the given timestamp
+         */
+        template <typename Storage>
+        bool restore(Storage& storage, uint16_t address, unsigned long offTime, BasicTimer::TickType current)
+        {
+            Record records[CAPACITY];
+            if (!load(storage, address, records)) return false;
+            for (uint8_t i = 0; i < entryCount; i++) {
+                entries[i].restore(entries[i].object, records[i], current - elapsedFor(records[i], offTime));
+            }
+            return true;
+        }
+
+        /**
+         * @brief Checks whether storage holds a valid snapshot for the 
+         *        registered objects, without restoring it
+         */
+        template <typename Storage>
+        bool verify(Storage& storage, uint16_t address = 0) const
+        {
+            Record records[CAPACITY];
+            return load(storage, address, records);
+        }
+
+    protected:
+        static constexpr uint8_t MagicLow = 'B';
+        static constexpr uint8_t MagicHigh = 'T';
+
+        /**
+         * @brief Record kinds, so a snapshot is not applied to a 
+         *        different list of objects
+         */
+        static constexpr uint8_t KindBasicTimer = 1;
+        static constexpr uint8_t KindCallbackTimer = 2;
+        static constexpr uint8_t KindBlinker = 3;
+
+        struct Record;
+
+        /**
+         * @brief Reads and checks a snapshot, reading each byte of storage
+         *        once
+         * 
+         * @param records Filled with one record per registered object
+         * @return true if every read succeeded and every check passed
+         */
+        template <typename Storage>
+        bool load(Storage& storage, uint16_t address, Record* records) const
+        {
+            Checksum checksum;
+            uint8_t header[HeaderSize];
+            if (!storage.read(address, header, HeaderSize)) return false;
+            if (header[0] != MagicLow || header[1] != MagicHigh || 
+                header[2] != FormatVersion || header[3] != entryCount) return false;
+            checksum.add(header, HeaderSize);
+            address += HeaderSize;
+
+            for (uint8_t i = 0; i < entryCount; i++) {
+                uint8_t bytes[RecordSize];
+                if (!storage.read(address, bytes, RecordSize)) return false;
+                if (bytes[0] != entries[i].kind) return false;
+                checksum.add(bytes, RecordSize);
+                records[i].unpack(bytes);
+                address += RecordSize;
+            }
+
+            uint8_t sum[ChecksumSize];
+            uint8_t expected[ChecksumSize];
+            if (!storage.read(address, sum, ChecksumSize)) return false;
+            checksum.pack(expected);
+            return sum[0] == expected[0] && sum[1] == expected[1];
+        }
+
+        /**
+         * @brief One saved object: kind, flags, then remaining time and 
+         *        timeout as 32 bit little endian values
+         */
+        struct Record
+        {
+            uint8_t kind;
+            uint8_t flags;
+            uint32_t remaining;
+            uint32_t timeout;
+
+            void pack(uint8_t* bytes) const
+            {
+                bytes[0] = kind;
+                bytes[1] = flags;
+                for (uint8_t i = 0; i < 4; i++) {
+                    bytes[2 + i] = static_cast<uint8_t>(remaining >> (8 * i));
+                    bytes[6 + i] = static_cast<uint8_t>(timeout >> (8 * i));
+                }
+            }
+
+            void unpack(const uint8_t* bytes)
+            {
+                kind = bytes[0];
+                flags = bytes[1];
+                remaining = 0;
+                timeout = 0;
+                for (uint8_t i = 0; i < 4; i++) {
+                    remaining |= static_cast<uint32_t>(bytes[2 + i]) << (8 * i);
+                    timeout |= static_cast<uint32_t>(bytes[6 + i]) << (8 * i);
+                }
+            }
+        };
+
+        /**
+         * @brief Fletcher-16 over the header and records
+         */
+        struct Checksum
+        {
+            uint16_t low = 0;
+            uint16_t high = 0;
+
+            void add(const uint8_t* bytes, uint16_t length)
+            {
+                for (uint16_t i = 0; i < length; i++) {
+                    low = (low + bytes[i]) % 255;
+                    high = (high + low) % 255;
+                }
+            }
+
+            void pack(uint8_t* bytes) const
+            {
+                bytes[0] = static_cast<uint8_t>(low);
+                bytes[1] = static_cast<uint8_t>(high);
+            }
+        };
+
+        /**
+         * @brief Type erased registered object
+         */
+        struct Entry
+        {
+            void* object;
+            uint8_t kind;
+            void (*save)(const void* object, Record& record, BasicTimer::TickType current);
+            void (*restore)(void* object, const Record& record, BasicTimer::TickType resetAt);
+        };
+
+        Entry entries[CAPACITY];
+        uint8_t entryCount;
+
+        bool add(void* object, uint8_t kind,
+                 void (*save)(const void*, Record&, BasicTimer::TickType),
+                 void (*restore)(void*, const Record&, BasicTimer::TickType))
+        {
+            if (entryCount >= CAPACITY) return false;
+            entries[entryCount].object = object;
+            entries[entryCount].kind = kind;
+            entries[entryCount].save = save;
+            entries[entryCount].restore = restore;
+            entryCount++;
+            return true;
+        }
+
+        /**
+         * @brief The time a restored timer should appear to have been 
+         *        running: what had elapsed at save() plus the time off, 
+         *        kept under half the clock range so it cannot wrap
+         */
+        static BasicTimer::TickType elapsedFor(const Record& record, unsigned long offTime)
+        {
+            const BasicTimer::TickType limit = BasicTimer::NoDeadline >> 1;
+            BasicTimer::TickType remaining = (record.remaining > record.timeout) ? 
+                                                record.timeout + 1 : record.remaining;
+            BasicTimer::TickType elapsed = static_cast<BasicTimer::TickType>(record.timeout + 1 - remaining);
+            if (elapsed > limit || offTime > limit - elapsed) return limit;
+            return static_cast<BasicTimer::TickType>(elapsed + offTime);
+        }
+
+        static void saveTimer(const void* object, Record& record, BasicTimer::TickType current)
+        {
+            const BasicTimer& timer = *static_cast<const BasicTimer*>(object);
+            record.flags = 0;
+            record.timeout = timer.timeout();
+            record.remaining = timer.timeRemaining(current);
+        }
+
+        static void restoreTimer(void* object, const Record& record, BasicTimer::TickType resetAt)
+        {
+            BasicTimer& timer = *static_cast<BasicTimer*>(object);
+            timer.setTimeout(record.timeout);
+            timer.reset(resetAt);
+        }
+
+        template <typename Callback, typename Stats>
+        static void saveCallbackTimer(const void* object, Record& record, BasicTimer::TickType current)
+        {
+            const TCallbackTimer<Callback, Stats>& timer = *static_cast<const TCallbackTimer<Callback, Stats>*>(object);
+            saveTimer(static_cast<const BasicTimer*>(&timer), record, current);
+            record.flags = timer.stateFlags;
+        }
+
+        template <typename Callback, typename Stats>
+        static void restoreCallbackTimer(void* object, const Record& record, BasicTimer::TickType resetAt)
+        {
+            TCallbackTimer<Callback, Stats>& timer = *static_cast<TCallbackTimer<Callback, Stats>*>(object);
+            restoreTimer(static_cast<BasicTimer*>(&timer), record, resetAt);
+            timer.stateFlags = record.flags;
+        }
+
+        static void saveBlinker(const void* object, Record& record, BasicTimer::TickType current)
+        {
+            const BasicBlinker& blinker = *static_cast<const BasicBlinker*>(object);
+            saveTimer(&blinker.timer, record, current);
+            record.flags = static_cast<uint8_t>(blinker.state | (blinker.runMode << 1));
+        }
+
+        static void restoreBlinker(void* object, const Record& record, BasicTimer::TickType resetAt)
+        {
+            BasicBlinker& blinker = *static_cast<BasicBlinker*>(object);
+            restoreTimer(&blinker.timer, record, resetAt);
+            blinker.state = record.flags & 0x1;
+            blinker.runMode = (record.flags >> 1) & 0x3;
+        }
+};
+
+template <uint8_t CAPACITY>
+constexpr uint8_t TimerSnapshot<CAPACITY>::FormatVersion;
+
+template <uint8_t CAPACITY>
+constexpr uint16_t TimerSnapshot<CAPACITY>::HeaderSize;
+
+template <uint8_t CAPACITY>
+constexpr uint16_t TimerSnapshot<CAPACITY>::RecordSize;
+
+template <uint8_t CAPACITY>
+constexpr uint16_t TimerSnapshot<CAPACITY>::ChecksumSize;
+
+/**
+ * @brief Snapshot storage in a RAM buffer.
+ * 
+ *    Place one in a .noinit section on AVR and a snapshot survives a 
+ *    watchdog or brownout reset (but not a power cycle) with no EEPROM 
+ *    wear at all:
+ * 
+ *        RamTimerStorage<64> resetSafe __attribute__((section(".noinit")));
+ * 
+ *    The checksum catches the random contents after a power cycle.
+ * 
+ * @tparam SIZE The buffer size in bytes
+ */
+template <uint16_t SIZE>
+class RamTimerStorage
+{
+    public:
+        bool read(uint16_t address, uint8_t* data, uint16_t length) const
+        {
+            if (address > SIZE || length > SIZE - address) return false;
+            memcpy(data, buffer + address, length);
+            return true;
+        }
+
+        bool write(uint16_t address, const uint8_t* data, uint16_t length)
+        {
+            if (address > SIZE || length > SIZE - address) return false;
+            memcpy(buffer + address, data, length);
+            return true;
+        }
+
+    protected:
+        uint8_t buffer[SIZE];
+};
+
+#if defined(__AVR__)
+/**
+ * @brief Snapshot storage in the AVR's internal EEPROM.  Only bytes that 
+ *        have changed are written, to save wear.
+ */
+class EepromTimerStorage
+{
+    public:
+        bool read(uint16_t address, uint8_t* data, uint16_t length) const
+        {
+            if (address > E2END + 1 || length > E2END + 1 - address) return false;
+            eeprom_read_block(data, reinterpret_cast<const void*>(address), length);
+            return true;
+        }
+
+        bool write(uint16_t address, const uint8_t* data, uint16_t length)
+        {
+            if (address > E2END + 1 || length > E2END + 1 - address) return false;
+            eeprom_update_block(data, reinterpret_cast<void*>(address), length);
+            return true;
+        }
+};
+#endif
+
+#endif /* _BASIC_TIMER_TIMER_SNAPSHOT_H_ */
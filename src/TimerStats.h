@@ -0,0 +1,228 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerStats.h
+//!  @brief TimerStats class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_TIMER_STATS_H_
+#define _BASIC_TIMER_TIMER_STATS_H_
+
+#include <Arduino.h>
+
+/**
+ * @brief Lateness statistics for one timer: how long after its deadline 
+ *        each expiry was noticed.
+ * 
+ *    StatsCallbackTimers and StatsDelegateTimers keep a TimerStats that 
+ *    run() records each expiry in:
+ * 
+ *        StatsCallbackTimer timer(100, blink, TIMER_RUN_MODE_PERIODIC);
+ *        ...
+ *        timer.stats().printTo(Serial);
+ * 
+ *    Plain CallbackTimers and DelegateTimers carry no statistics and no 
+ *    extra code, and both kinds can be used in the same sketch.
+ *    A timer whose mean or maximum lateness is high is being starved by 
+ *    its place in loop().
+ * 
+ *    Lateness is in clock ticks (milliseconds for a CallbackTimer), 
+ *    counted from the first tick at which the timer could have been seen 
+ *    to expire, so a timer run in time has a lateness of 0.  The histogram
+ *    has a bucket for 0 and then one for each power of two: 1, 2-3, 4-7, 
+ *    8-15, 16-31, 32-63 and 64 or more.
+ * 
+ *    Jitter is the change in lateness from one expiry to the next.  A timer
+ *    that is always 5 ticks late has no jitter, which a periodic output 
+ *    can tolerate; one that swings between 0 and 5 has a jitter of 5.
+ */
+class TimerStats
+{
+    public:
+        /**
+         * @brief The number of histogram buckets
+         */
+        static constexpr uint8_t BucketCount = 8;
+
+        /**
+         * @brief Construct a new, empty TimerStats
+         */
+        TimerStats() { clear(); };
+
+        /**
+         * @brief Discards everything recorded so far
+         */
+        void clear()
+        {
+            fires = 0;
+            latenessSum = 0;
+            latenessMin = 0;
+            latenessMax = 0;
+            latenessLast = 0;
+            jitterSum = 0;
+            jitterMax = 0;
+            for (uint8_t i = 0; i < BucketCount; i++) {
+                buckets[i] = 0;
+            }
+        }
+
+        /**
+         * @brief Records one expiry
+         * 
+         * @param lateness The time between the deadline and the expiry 
+         *        being noticed, in clock ticks
+         */
+        void record(uint32_t lateness)
+        {
+            if (fires == 0 || lateness < latenessMin) latenessMin = lateness;
+            if (lateness > latenessMax) latenessMax = lateness;
+            if (fires > 0) {
+                uint32_t jitter = (lateness > latenessLast) ? lateness - latenessLast : latenessLast - lateness;
+                if (jitter > jitterMax) jitterMax = jitter;
+                jitterSum += jitter;
+            }
+            latenessLast = lateness;
+            latenessSum += lateness;
+            fires++;
+            uint8_t bucket = 0;
+            while (lateness != 0 && bucket < BucketCount - 1) {
+                lateness >>= 1;
+                bucket++;
+            }
+            if (buckets[bucket] != 0xFFFF) buckets[bucket]++;
+        }
+
+        /**
+         * @brief The number of expiries recorded
+         */
+        uint32_t fireCount() const { return fires; };
+
+        /**
+         * @brief The smallest lateness recorded, 0 if none
+         */
+        uint32_t minLateness() const { return latenessMin; };
+
+        /**
+         * @brief The largest lateness recorded, 0 if none
+         */
+        uint32_t maxLateness() const { return latenessMax; };
+
+        /**
+         * @brief The mean lateness, rounded down, 0 if none
+         */
+        uint32_t meanLateness() const { return fires ? latenessSum / fires : 0; };
+
+        /**
+         * @brief The mean change in lateness between consecutive expiries,
+         *        rounded down, 0 if fewer than two
+         */
+        uint32_t meanJitter() const { return (fires > 1) ? jitterSum / (fires - 1) : 0; };
+
+        /**
+         * @brief The largest change in lateness between consecutive 
+         *        expiries, 0 if fewer than two
+         */
+        uint32_t maxJitter() const { return jitterMax; };
+
+        /**
+         * @brief The count in one histogram bucket, saturating at 65535
+         * 
+         * @param bucket The bucket number, less than BucketCount
+         */
+        uint16_t bucket(uint8_t bucket) const { return buckets[bucket]; };
+
+        /**
+         * @brief Prints the statistics on one line, for example 
+         * 
+         *        fires=120 late min=0 mean=1 max=14 jitter mean=1 max=13 hist=[98 10 7 4 1 0 0 0]
+         * 
+         * @param out The stream to print to, such as Serial
+         * @return size_t The number of characters printed
+         */
+        size_t printTo(Print& out) const
+        {
+            size_t count = out.print(F("fires="));
+            count += out.print(fires);
+            count += out.print(F(" late min="));
+            count += out.print(latenessMin);
+            count += out.print(F(" mean="));
+            count += out.print(meanLateness());
+            count += out.print(F(" max="));
+            count += out.print(latenessMax);
+            count += out.print(F(" jitter mean="));
+            count += out.print(meanJitter());
+            count += out.print(F(" max="));
+            count += out.print(jitterMax);
+            count += out.print(F(" hist=["));
+            for (uint8_t i = 0; i < BucketCount; i++) {
+                if (i > 0) count += out.print(' ');
+                count += out.print(buckets[i]);
+            }
+            count += out.println(']');
+            return count;
+        }
+
+    protected:
+        uint32_t fires;
+        uint32_t latenessSum;
+        uint32_t latenessMin;
+        uint32_t latenessMax;
+        uint32_t latenessLast;
+        uint32_t jitterSum;
+        uint32_t jitterMax;
+        uint16_t buckets[BucketCount];
+};
+
+#endif /* _BASIC_TIMER_TIMER_STATS_H_ */
@@ -0,0 +1,539 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  TimerWheel.h
+//!  @brief TimerWheel scheduler class definitions
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+#ifndef _BASIC_TIMER_TIMER_WHEEL_H_
+#define _BASIC_TIMER_TIMER_WHEEL_H_
+
+#include "./TimerCore.h"
+#include "./CallbackTimer.h"
+
+template <uint8_t SLOT_BITS, uint8_t LEVELS, unsigned long TICK>
+class TimerWheel;
+
+/**
+ * @brief A callback timer that is scheduled by a TimerWheel instead of 
+ *        being polled.
+ * 
+ *    A WheelTimer holds the same settings as a CallbackTimer (timeout, 
+ *    callback and run mode) but it has no run() function.  It is started 
+ *    and stopped through a TimerWheel, and the wheel's service() function 
+ *    executes the callback when the timer expires.
+ * 
+ *    A started WheelTimer is linked into its wheel, so it must not be 
+ *    destroyed or copied while it is running.
+ * 
+ * @see TimerWheel
+ */
+class WheelTimer
+{
+    template <uint8_t SLOT_BITS, uint8_t LEVELS, unsigned long TICK>
+    friend class TimerWheel;
+
+    public:
+        /**
+         * @brief onExpire callback handler type
+         */
+        typedef CallbackTimer::OnExpireFunction OnExpireFunction;
+
+        /**
+         * @brief Construct a new WheelTimer object with the provided timeout and callback
+         * 
+         * @param timeout The timeout in milliseconds
+         * @param callback The onExpire callback function
+         * @param mode The timer mode - defaults to TIMER_RUN_MODE_ONE_SHOT
+         */
+        WheelTimer(unsigned long timeout = 500, 
+                   OnExpireFunction callback = nullptr, 
+                   TimerRunMode mode = TIMER_RUN_MODE_ONE_SHOT):
+                        next(nullptr),
+                        pprev(nullptr),
+                        expires(0),
+                        storedTimeout(timeout),
+                        expiredCallback(callback),
+                        stateFlags(static_cast<uint8_t>(mode) & TimerModeMask)
+                        {};
+
+        WheelTimer(const WheelTimer&) = delete;
+        WheelTimer& operator=(const WheelTimer&) = delete;
+
+        /**
+         * @brief Set the timer's timeout to the supplied value.  Takes effect 
+         *        the next time the timer is started.
+         * 
+         * @param timeout The new timer period in milliseconds
+         */
+        void setTimeout(unsigned long timeout){ storedTimeout = timeout; };
+
+        /**
+         * @brief Returns the timer's stored timeout time in milliseconds
+         * 
+         * @return unsigned long 
+         */
+        unsigned long timeout() const { return storedTimeout; };
+
+        /**
+         * @brief Assign a callback function to be called on time expire
+         * 
+         * @param callback The onExpire callback function
+         */
+        void onExpire(OnExpireFunction callback){ expiredCallback = callback; };
+
+        /**
+         * @brief Sets the timer mode.  
+         * 
+         * @param mode The TimerRunMode
+         * @see TimerRunMode
+         */
+        void setMode(TimerRunMode mode) {
+            uint8_t currentState = stateFlags & (~TimerModeMask);
+            uint8_t newMode = mode & TimerModeMask;
+            stateFlags = currentState | newMode;
+        }
+
+        /**
+         * @brief Gets the current timer mode
+         * 
+         * @return TimerRunMode 
+         */
+        TimerRunMode mode() const {
+            return static_cast<TimerRunMode>(stateFlags & TimerModeMask);
+        }
+
+        /**
+         * @brief Gets if the time has been started
+         * 
+         * @return bool
+         */
+        bool hasStarted() const {
+            return (stateFlags & (1 << StartFlagBit));
+        }
+
+        /**
+         * @brief Checks if the time has expired previously
+         * 
+         * @return true if the timeout has reached expiration
+         * @return false if not
+         */
+        bool hasPreviouslyExpired() const {
+            return (stateFlags & (1 << ExpireFlagBit));
+        }
+
+        /**
+         * @brief Checks if the timer is currently linked into a wheel 
+         *        and waiting to expire.
+         * 
+         * @return bool
+         */
+        bool isPending() const { return pprev != nullptr; };
+
+    protected:
+        /**
+         * @brief Constexpr mask for getting/setting the timer mode from 
+         *        stateFlags
+         */
+        static constexpr uint8_t TimerModeMask = 0x3;
+
+        /**
+         * @brief Bit position in stateFlags for the start flag
+         */
+        static constexpr uint8_t StartFlagBit = 6;
+
+        /**
+         * @brief Bit position in stateFlags for the expired flag
+         */
+        static constexpr uint8_t ExpireFlagBit = 7;
+
+        /**
+         * @brief Next timer in the same wheel slot
+         */
+        WheelTimer* next;
+
+        /**
+         * @brief Pointer to the link that points at this timer, 
+         *        nullptr when the timer is not in a wheel.
+         */
+        WheelTimer** pprev;
+
+        /**
+         * @brief The wheel tick at which the timer expires
+         */
+        unsigned long expires;
+
+        /**
+         * @brief The timeout value in milliseconds
+         */
+        unsigned long storedTimeout;
+
+        /**
+         * @brief On expire callback pointer storage
+         */
+        OnExpireFunction expiredCallback;
+
+        /**
+         * @brief State storage as bit flags to reduce memory footprint
+         */
+        uint8_t stateFlags;
+};
+
+/**
+ * @brief Hierarchical timing wheel that schedules many WheelTimers from a 
+ *        single service() call.
+ * 
+ *    Polling N CallbackTimers costs N checks every loop, even if none of them
+ *    are due.  A TimerWheel sorts its timers into slots by expiry tick, so 
+ *    starting or stopping a timer is O(1) and service() only visits the slot 
+ *    for each tick that has passed.  Timers further away than one level can
+ *    hold are kept in a coarser level and moved down ("cascaded") as their 
+ *    expiry approaches.
+ * 
+ *    The wheel covers 2^(SLOT_BITS * LEVELS) ticks directly; longer timeouts
+ *    still work, they are just cascaded through the top level more than once
+ *    (or, with a single level, passed over until the wheel comes round to 
+ *    their expiry).
+ *    The memory cost is LEVELS * 2^SLOT_BITS pointers (128 bytes on AVR with 
+ *    the default settings).
+ * 
+ *    A timer started with timeout T fires on the first tick at which more 
+ *    than T milliseconds have passed, so a wheel with TICK = 1 behaves the 
+ *    same as polling a CallbackTimer.  A coarser TICK trades resolution for
+ *    less work per millisecond.
+ * 
+ * @tparam SLOT_BITS log2 of the number of slots per level, 1 to 7
+ * @tparam LEVELS The number of levels in the wheel
+ * @tparam TICK The wheel resolution in milliseconds
+ */
+template <uint8_t SLOT_BITS = 4, uint8_t LEVELS = 4, unsigned long TICK = 1>
+class TimerWheel
+{
+    static_assert(SLOT_BITS > 0 && LEVELS > 0, "TimerWheel needs at least one slot bit and one level");
+    static_assert(SLOT_BITS <= 7, "TimerWheel levels hold at most 128 slots");
+    static_assert(SLOT_BITS * LEVELS <= 30, "TimerWheel range must fit in 30 bits of ticks");
+    static_assert(TICK > 0, "TimerWheel tick must be at least 1ms");
+
+    public:
+        /**
+         * @brief Construct a new, empty TimerWheel
+         */
+        TimerWheel(): base(0), lastTick(BasicTimer::now()), pendingCount(0)
+        {
+            for (uint8_t level = 0; level < LEVELS; level++) {
+                for (uint8_t slot = 0; slot < SlotCount; slot++) {
+                    slots[level][slot] = nullptr;
+                }
+            }
+        };
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        /**
+         * @brief Prepares the wheel for use by syncing it to the current time.
+         *        Should be called from setup() before any timer is started.
+         */
+        void begin() { lastTick = BasicTimer::now(); };
+
+        /**
+         * @brief Starts or restarts a timer with its previously set timeout
+         *        and mode.
+         * 
+         * @param timer The timer to start
+         */
+        void start(WheelTimer& timer)
+        {
+            detach(timer);
+            bitSet(timer.stateFlags, WheelTimer::StartFlagBit);
+            bitClear(timer.stateFlags, WheelTimer::ExpireFlagBit);
+            timer.expires = currentTick() + ticksFor(timer.storedTimeout);
+            attach(timer);
+        }
+
+        /**
+         * @brief Sets the timeout and mode of a timer, then starts it
+         * 
+         * @param timer The timer to start
+         * @param timeout The timeout in milliseconds
+         * @param mode The timer mode - defaults to TIMER_RUN_MODE_ONE_SHOT
+         */
+        void begin(WheelTimer& timer, unsigned long timeout, 
+                   TimerRunMode mode = TIMER_RUN_MODE_ONE_SHOT)
+        {
+            timer.setTimeout(timeout);
+            timer.setMode(mode);
+            start(timer);
+        }
+
+        /**
+         * @brief Stops a timer, removing it from the wheel
+         * 
+         * @param timer The timer to stop
+         */
+        void stop(WheelTimer& timer)
+        {
+            detach(timer);
+            bitClear(timer.stateFlags, WheelTimer::StartFlagBit);
+        }
+
+        /**
+         * @brief Runs the wheel.
+         * 
+         *      This function should be called from the main loop and 
+         *      it will execute the callback of every timer that has 
+         *      expired since the last call.
+         */
+        void service()
+        {
+            BasicTimer::TickType current = BasicTimer::now();
+            if (pendingCount == 0) {
+                unsigned long skipped = static_cast<BasicTimer::TickType>(current - lastTick) / TICK;
+                lastTick += skipped * TICK;
+                base += skipped;
+                return;
+            }
+            while (static_cast<BasicTimer::TickType>(current - lastTick) >= TICK) {
+                lastTick += TICK;
+                runTick();
+            }
+        }
+
+        /**
+         * @brief The number of timers currently waiting in the wheel
+         * 
+         * @return unsigned int 
+         */
+        unsigned int pending() const { return pendingCount; };
+
+    protected:
+        /**
+         * @brief The number of slots in each level
+         */
+        static constexpr uint8_t SlotCount = 1 << SLOT_BITS;
+
+        /**
+         * @brief Mask for getting a slot index from a tick
+         */
+        static constexpr unsigned long SlotMask = SlotCount - 1;
+
+        /**
+         * @brief The largest tick offset the wheel can place directly
+         */
+        static constexpr unsigned long MaxOffset = (1UL << (SLOT_BITS * LEVELS)) - 1;
+
+        /**
+         * @brief Slot list heads, indexed by level and slot
+         */
+        WheelTimer* slots[LEVELS][SlotCount];
+
+        /**
+         * @brief The next tick to be processed
+         */
+        unsigned long base;
+
+        /**
+         * @brief The timestamp in milliseconds of the last processed tick
+         */
+        BasicTimer::TickType lastTick;
+
+        /**
+         * @brief The number of timers linked into the wheel
+         */
+        unsigned int pendingCount;
+
+        /**
+         * @brief The number of ticks needed for a timeout to pass
+         */
+        static unsigned long ticksFor(unsigned long timeout)
+        {
+            return (timeout + TICK - 1) / TICK;
+        }
+
+        /**
+         * @brief The tick the wheel would be at if service() was called now
+         */
+        unsigned long currentTick() const
+        {
+            return base + static_cast<BasicTimer::TickType>(BasicTimer::now() - lastTick) / TICK;
+        }
+
+        /**
+         * @brief Links a timer into the slot matching its expiry tick
+         */
+        void attach(WheelTimer& timer)
+        {
+            unsigned long offset = timer.expires - base;
+            WheelTimer** head;
+            if (static_cast<long>(offset) < 0) {
+                head = &slots[0][base & SlotMask];
+            } else {
+                if (offset > MaxOffset) offset = MaxOffset;
+                unsigned long when = base + offset;
+                uint8_t level = 0;
+                while (level < LEVELS - 1 && offset >= (1UL << (SLOT_BITS * (level + 1)))) {
+                    level++;
+                }
+                head = &slots[level][(when >> (SLOT_BITS * level)) & SlotMask];
+            }
+            timer.next = *head;
+            if (timer.next != nullptr) timer.next->pprev = &timer.next;
+            timer.pprev = head;
+            *head = &timer;
+            pendingCount++;
+        }
+
+        /**
+         * @brief Unlinks a timer from whatever list it is in
+         */
+        void detach(WheelTimer& timer)
+        {
+            if (timer.pprev == nullptr) return;
+            *timer.pprev = timer.next;
+            if (timer.next != nullptr) timer.next->pprev = timer.pprev;
+            timer.next = nullptr;
+            timer.pprev = nullptr;
+            pendingCount--;
+        }
+
+        /**
+         * @brief Re-files every timer in a slot of a coarser level
+         * 
+         * @return The index of the slot that was cascaded
+         */
+        uint8_t cascade(uint8_t level, uint8_t index)
+        {
+            WheelTimer* timer = slots[level][index];
+            slots[level][index] = nullptr;
+            while (timer != nullptr) {
+                WheelTimer* following = timer->next;
+                timer->pprev = nullptr;
+                pendingCount--;
+                attach(*timer);
+                timer = following;
+            }
+            return index;
+        }
+
+        /**
+         * @brief Moves a periodic timer's expiry on, keeping its phase.  
+         * 
+         *        In catch up mode the expiry moves one period, so an overdue
+         *        timer fires again on a following tick for every missed 
+         *        period.  Otherwise it moves by whole periods to the first 
+         *        expiry after the current time, by the same rule as 
+         *        TBasicTimer::advance(), so a wheel timer and a PERIODIC 
+         *        CallbackTimer fire at the same times.
+         */
+        void advance(WheelTimer& timer, unsigned long period, bool skipMissed)
+        {
+            if (skipMissed) {
+                // In ticks, the timer was last "reset" one period before 
+                // the expiry that just fired
+                unsigned long lastReset = timer.expires - period;
+                unsigned long elapsed = currentTick() - lastReset;
+                unsigned long periods = (elapsed > period) ? (elapsed - 1) / period : 1;
+                timer.expires = lastReset + periods * period + period;
+            } else {
+                timer.expires += period;
+            }
+            bitClear(timer.stateFlags, WheelTimer::ExpireFlagBit);
+            attach(timer);
+        }
+
+        /**
+         * @brief Processes a single tick, firing the timers in its slot
+         */
+        void runTick()
+        {
+            uint8_t index = base & SlotMask;
+            if (index == 0) {
+                for (uint8_t level = 1; level < LEVELS; level++) {
+                    if (cascade(level, (base >> (SLOT_BITS * level)) & SlotMask) != 0) break;
+                }
+            }
+            base++;
+
+            WheelTimer* expired = slots[0][index];
+            slots[0][index] = nullptr;
+            if (expired != nullptr) expired->pprev = &expired;
+
+            // Callbacks may start or stop any timer, including ones still
+            // waiting in this list, so always take the list head fresh.
+            while (expired != nullptr) {
+                WheelTimer& timer = *expired;
+                detach(timer);
+                // A timer beyond the range of a single level wheel is parked
+                // in level 0 and comes round again until it is really due
+                if (static_cast<long>(timer.expires - base) >= 0) {
+                    attach(timer);
+                    continue;
+                }
+                bitSet(timer.stateFlags, WheelTimer::ExpireFlagBit);
+                TimerRunMode runMode = timer.mode();
+                unsigned long period = ticksFor(timer.storedTimeout);
+                if (runMode == TIMER_RUN_MODE_CONTINUOUS || 
+                    (runMode != TIMER_RUN_MODE_ONE_SHOT && period == 0)) {
+                    start(timer);
+                } else if (runMode != TIMER_RUN_MODE_ONE_SHOT) {
+                    advance(timer, period, runMode == TIMER_RUN_MODE_PERIODIC);
+                }
+                if (timer.expiredCallback != nullptr) {
+                    timer.expiredCallback();
+                }
+            }
+        }
+};
+
+#endif /* _BASIC_TIMER_TIMER_WHEEL_H_ */
@@ -0,0 +1,316 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+//!  @file  WatchdogSupervisor.h
+//!  @brief WatchdogSupervisor class definition
+//!
+//!  @author Nate Taylor \n
+//!  Contact: nate@rtelectronix.com
+//!  @copyright (C) 2020 Nate Taylor - All Rights Reserved.
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                    MMMMMMMMMMMMMMMMMMMMMM   NNNNNNNNNNNNNNNNNN                          |
+//      |                   MMMMMMMMM    MMMMMMMMMM       NNNNNMNNN                               |
+//      |                   MMMMMMMM:    MMMMMMMMMM       NNNNNNNN                                |
+//      |                  MMMMMMMMMMMMMMMMMMMMMMM       NNNNNNNNN                                |
+//      |                 MMMMMMMMMMMMMMMMMMMMMM         NNNNNNNN                                 |
+//      |                 MMMMMMMM     MMMMMMM          NNNNNNNN                                  |
+//      |                MMMMMMMMM    MMMMMMMM         NNNNNNNNN                                  |
+//      |                MMMMMMMM     MMMMMMM          NNNNNNNN                                   |
+//      |               MMMMMMMM     MMMMMMM          NNNNNNNNN                                   |
+//      |                           MMMMMMMM        NNNNNNNNNN                                    |
+//      |                          MMMMMMMMM       NNNNNNNNNNN                                    |
+//      |                          MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                |
+//      |                        MMMMMMM      E L E C T R O N I X         MMMMMM                  |
+//      |                         MMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMMM                    |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//      |-----------------------------------------------------------------------------------------|
+//      |                                                                                         |
+//      |      [MIT License]                                                                      |
+//      |                                                                                         |
+//      |      Copyright (c) 2020 Nathaniel Taylor                                                |
+//      |                                                                                         |
+//      |      Permission is hereby granted, free of charge, to any person obtaining a copy       |
+//      |      of this software and associated documentation files (the "Software"), to deal      |
+//      |      in the Software without restriction, including without limitation the rights       |
+//      |      to use, copy, modify, merge, publish, distribute, sublicense, and/or sell          |
+//      |      copies of the Software, and to permit persons to whom the Software is              |
+//      |      furnished to do so, subject to the following conditions:                           |
+//      |                                                                                         |
+//      |      The above copyright notice and this permission notice shall be included in all     |
+//      |      copies or substantial portions of the Software.                                    |
+//      |                                                                                         |
+//      |      THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR         |
+//      |      IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,           |
+//      |      FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE        |
+//      |      AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER             |
+//      |      LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,      |
+//      |      OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE      |
+//      |      SOFTWARE.                                                                          |
+//      |                                                                                         |
+//      |-----------------------------------------------------------------------------------------|
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+#ifndef _BASIC_TIMER_WATCHDOG_SUPERVISOR_H_
+#define _BASIC_TIMER_WATCHDOG_SUPERVISOR_H_
+
+#include "./TimerCore.h"
+
+/**
+ * @brief A software watchdog with one channel per subsystem, each with its
+ *        own timeout.
+ * 
+ *    A hardware watchdog can only tell that the whole sketch has stopped.
+ *    A WatchdogSupervisor gives each subsystem a channel that it kicks 
+ *    whenever it makes progress; check() then finds every channel that 
+ *    has gone longer than its timeout without a kick and calls the starved
+ *    callback once for each, so the sketch can log or restart that one 
+ *    subsystem.  The usual pattern is to feed the hardware watchdog only 
+ *    while every channel is healthy:
+ * 
+ *        WatchdogSupervisor<4> supervisor(onStarved);
+ *        uint8_t radioChannel = supervisor.add(2000);
+ *        ...
+ *        supervisor.kick(radioChannel);      // from the radio code
+ *        ...
+ *        if (supervisor.check() == 0) wdt_reset();
+ * 
+ *    Each channel's deadline is kept as a timestamp in one array, so 
+ *    check() is a subtraction and a comparison per channel.  Deadlines are 
+ *    compared as signed differences, so timeouts must be less than half 
+ *    the clock's range (about 24 days for millis()).  A starved channel is
+ *    reported once and stays starved until it is kicked again.
+ * 
+ * @tparam CHANNELS The number of channels, 1 to 32
+ * @tparam Clock The clock policy used for timestamps
+ */
+template <uint8_t CHANNELS, typename Clock = MillisClock>
+class WatchdogSupervisor
+{
+    static_assert(CHANNELS >= 1 && CHANNELS <= 32, "WatchdogSupervisor holds 1 to 32 channels");
+
+    public:
+        /**
+         * @brief The timestamp type of the clock policy
+         */
+        typedef typename Clock::TickType TickType;
+
+        /**
+         * @brief A bitmask with one bit per channel, bit i for channel i
+         */
+        typedef uint32_t ChannelMask;
+
+        /**
+         * @brief Callback for a starved channel, given the channel number
+         */
+        typedef void(*OnStarvedFunction)(uint8_t channel);
+
+        /**
+         * @brief Returned by add() when every channel is in use
+         */
+        static constexpr uint8_t NoChannel = 0xFF;
+
+        /**
+         * @brief Returned by timeRemaining() when no channel can starve
+         */
+        static constexpr TickType NoDeadline = static_cast<TickType>(~TickType(0));
+
+        /**
+         * @brief Construct a new WatchdogSupervisor with no channels
+         * 
+         * @param callback Function to call once for each channel that 
+         *        starves, or nullptr
+         */
+        WatchdogSupervisor(OnStarvedFunction callback = nullptr): 
+                        starvedCallback(callback), channelCount(0), 
+                        enabledBits(0), starvedBits(0)
+        {
+            for (uint8_t i = 0; i < CHANNELS; i++) {
+                deadlines[i] = 0;
+                timeouts[i] = 0;
+            }
+        };
+
+        /**
+         * @brief Adds an enabled channel, counting from now
+         * 
+         * @param timeout The longest time allowed between kicks, in clock ticks
+         * @return uint8_t The channel number to pass to kick(), or 
+         *         NoChannel if every channel is in use
+         */
+        uint8_t add(TickType timeout)
+        {
+            if (channelCount >= CHANNELS) return NoChannel;
+            uint8_t channel = channelCount++;
+            timeouts[channel] = timeout;
+            enable(channel);
+            return channel;
+        };
+
+        /**
+         * @brief Records progress on a channel, pushing its deadline out by 
+         *        its timeout and clearing its starved state
+         * 
+         * @param channel The channel number from add()
+         */
+        void kick(uint8_t channel) { kick(channel, Clock::now()); };
+
+        /**
+         * @brief Records progress on a channel at the given timestamp
+         */
+        void kick(uint8_t channel, TickType current)
+        {
+            if (channel >= channelCount) return;
+            deadlines[channel] = static_cast<TickType>(current + timeouts[channel]);
+            starvedBits &= ~maskOf(channel);
+        };
+
+        /**
+         * @brief Finds starved channels and reports newly starved ones 
+         *        through the callback; call every loop()
+         * 
+         * @return ChannelMask Every channel that is currently starved, 
+         *         0 if all are healthy
+         */
+        ChannelMask check() { return check(Clock::now()); };
+
+        /**
+         * @brief Finds channels starved at the given timestamp
+         */
+        ChannelMask check(TickType current)
+        {
+            ChannelMask watched = enabledBits & ~starvedBits;
+            for (uint8_t i = 0; i < channelCount; i++) {
+                ChannelMask mask = maskOf(i);
+                if (!(watched & mask)) continue;
+                if (!isPast(deadlines[i], current)) continue;
+                starvedBits |= mask;
+                if (starvedCallback) starvedCallback(i);
+            }
+            return starvedBits;
+        };
+
+        /**
+         * @brief Alias for check() so a supervisor can join a TimerGroup
+         */
+        void run(TickType current) { check(current); };
+
+        /**
+         * @brief Starts watching a channel again, counting from now
+         */
+        void enable(uint8_t channel)
+        {
+            if (channel >= channelCount) return;
+            enabledBits |= maskOf(channel);
+            kick(channel);
+        };
+
+        /**
+         * @brief Stops watching a channel, for a subsystem that is 
+         *        deliberately idle.  A disabled channel is never starved.
+         */
+        void disable(uint8_t channel)
+        {
+            if (channel >= channelCount) return;
+            enabledBits &= ~maskOf(channel);
+            starvedBits &= ~maskOf(channel);
+        };
+
+        /**
+         * @brief Changes a channel's timeout, taking effect at its next kick
+         */
+        void setTimeout(uint8_t channel, TickType timeout)
+        {
+            if (channel < channelCount) timeouts[channel] = timeout;
+        };
+
+        /**
+         * @brief A channel's timeout in clock ticks
+         */
+        TickType timeout(uint8_t channel) const 
+        { 
+            return (channel < channelCount) ? timeouts[channel] : 0; 
+        };
+
+        /**
+         * @brief Checks if a channel was starved at the last check()
+         */
+        bool isStarved(uint8_t channel) const { return starvedBits & maskOf(channel); };
+
+        /**
+         * @brief Every channel starved at the last check()
+         */
+        ChannelMask starved() const { return starvedBits; };
+
+        /**
+         * @brief The number of channels added
+         */
+        uint8_t channels() const { return channelCount; };
+
+        /**
+         * @brief Sets the function called for each newly starved channel
+         */
+        void onStarved(OnStarvedFunction callback) { starvedCallback = callback; };
+
+        /**
+         * @brief The time until the next enabled, healthy channel starves
+         * 
+         * @param current The current clock timestamp
+         * @return TickType The time in clock ticks, 0 if one is already 
+         *         past its deadline, NoDeadline if none is being watched
+         */
+        TickType timeRemaining(TickType current) const
+        {
+            ChannelMask watched = enabledBits & ~starvedBits;
+            TickType next = NoDeadline;
+            for (uint8_t i = 0; i < channelCount; i++) {
+                if (!(watched & maskOf(i))) continue;
+                if (isPast(deadlines[i], current)) return 0;
+                TickType remaining = static_cast<TickType>(deadlines[i] - current + 1);
+                if (remaining < next) next = remaining;
+            }
+            return next;
+        };
+
+    protected:
+        OnStarvedFunction starvedCallback;
+        uint8_t channelCount;
+        ChannelMask enabledBits;
+        ChannelMask starvedBits;
+
+        /**
+         * @brief Absolute deadline of each channel
+         */
+        TickType deadlines[CHANNELS];
+
+        /**
+         * @brief Timeout of each channel, applied at every kick
+         */
+        TickType timeouts[CHANNELS];
+
+        static ChannelMask maskOf(uint8_t channel) { return ChannelMask(1) << channel; };
+
+        /**
+         * @brief Checks if current is after deadline, with the same 
+         *        "more than timeout" rule as BasicTimer::hasExpired()
+         */
+        static bool isPast(TickType deadline, TickType current)
+        {
+            TickType late = static_cast<TickType>(current - deadline);
+            return late != 0 && late <= (NoDeadline >> 1);
+        };
+};
+
+template <uint8_t CHANNELS, typename Clock>
+constexpr uint8_t WatchdogSupervisor<CHANNELS, Clock>::NoChannel;
+
+template <uint8_t CHANNELS, typename Clock>
+constexpr typename WatchdogSupervisor<CHANNELS, Clock>::TickType WatchdogSupervisor<CHANNELS, Clock>::NoDeadline;
+
+#endif /* _BASIC_TIMER_WATCHDOG_SUPERVISOR_H_ */